@@ -24,6 +24,7 @@ void BBVariable::unref() {
 void BBVariable::set_value(const Variant &p_value) {
 	data->value = p_value; // Setting value even when bound as a fallback in case the binding fails.
 	data->value_changed = true;
+	data->version += 1;
 
 	if (is_bound()) {
 		Object *obj = OBJECT_DB_GET_INSTANCE(data->bound_object);
@@ -54,6 +55,19 @@ Variant BBVariable::get_value() const {
 	return data->value;
 }
 
+bool BBVariable::poll_bound_value() const {
+	if (!is_bound()) {
+		return false;
+	}
+	Variant value = get_value();
+	if (value == data->value) {
+		return false;
+	}
+	data->value = value;
+	data->version += 1;
+	return true;
+}
+
 void BBVariable::set_type(Variant::Type p_type) {
 	data->type = p_type;
 	data->value = VARIANT_DEFAULT(p_type);
@@ -120,6 +134,7 @@ void BBVariable::bind(Object *p_object, const StringName &p_property) {
 	ERR_FAIL_COND_MSG(!OBJECT_HAS_PROPERTY(p_object, p_property), vformat("Blackboard: Binding failed - %s has no property `%s`.", p_object, p_property));
 	data->bound_object = p_object->get_instance_id();
 	data->bound_property = p_property;
+	data->value = p_object->get(p_property); // Baseline for poll_bound_value().
 }
 
 void BBVariable::unbind() {
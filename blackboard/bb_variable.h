@@ -29,6 +29,9 @@ private:
 		// Is used to decide if the value needs to be synced in a derived plan.
 		bool value_changed = false;
 
+		// Incremented on every write - used to detect changes without comparing values.
+		uint32_t version = 0;
+
 		SafeRefCount refcount;
 		Variant value;
 		Variant::Type type = Variant::NIL;
@@ -61,6 +64,10 @@ public:
 	_FORCE_INLINE_ bool is_value_changed() const { return data->value_changed; }
 	_FORCE_INLINE_ void reset_value_changed() { data->value_changed = false; }
 
+	_FORCE_INLINE_ uint32_t get_version() const { return data->version; }
+	// Detects writes made directly to a bound property and bumps the version. Returns true if the value changed.
+	bool poll_bound_value() const;
+
 	bool is_same_prop_info(const BBVariable &p_other) const;
 	void copy_prop_info(const BBVariable &p_other);
 
@@ -10,7 +10,10 @@
  */
 
 #include "blackboard.h"
+#include "../compat/object.h"
 #include "../compat/print.h"
+#include "../util/limbo_metrics.h"
+#include "../util/limbo_string_names.h"
 
 Ref<Blackboard> Blackboard::top() const {
 	Ref<Blackboard> bb(this);
@@ -21,6 +24,7 @@ Ref<Blackboard> Blackboard::top() const {
 }
 
 Variant Blackboard::get_var(const StringName &p_name, const Variant &p_default, bool p_complain) const {
+	LimboMetrics::count_blackboard_lookup();
 	if (data.has(p_name)) {
 		return data.get(p_name).get_value();
 	} else if (parent.is_valid()) {
@@ -42,6 +46,94 @@ void Blackboard::set_var(const StringName &p_name, const Variant &p_value) {
 		var.set_value(p_value);
 		data.insert(p_name, var);
 	}
+	if (unlikely(change_notification != CHANGE_NOTIFICATION_DISABLED)) {
+		_notify_var_changed(p_name, p_value);
+	}
+}
+
+void Blackboard::_notify_var_changed(const StringName &p_name, const Variant &p_value) {
+	if (change_notification == CHANGE_NOTIFICATION_IMMEDIATE) {
+		emit_signal(LW_NAME(var_changed), p_name, p_value);
+	} else if (!pending_changes.has(p_name)) {
+		if (pending_changes.is_empty() && parent.is_valid()) {
+			// Register with the top-most scope, so that flushing it reaches this scope too.
+			Blackboard *top_bb = parent.ptr();
+			while (top_bb->parent.is_valid()) {
+				top_bb = top_bb->parent.ptr();
+			}
+			top_bb->dirty_scopes.push_back(get_instance_id());
+		}
+		pending_changes.insert(p_name);
+	}
+}
+
+void Blackboard::_poll_bound_vars() {
+	for (const KeyValue<StringName, BBVariable> &kv : data) {
+		if (kv.value.is_bound() && kv.value.poll_bound_value()) {
+			_notify_var_changed(kv.key, kv.value.get_value());
+		}
+	}
+}
+
+void Blackboard::flush_changes() {
+	if (!dirty_scopes.is_empty()) {
+		Vector<ObjectID> scopes = dirty_scopes;
+		dirty_scopes.clear();
+		for (int i = 0; i < scopes.size(); i++) {
+			// Skips scopes that were freed since they registered.
+			Ref<Blackboard> scope = Object::cast_to<Blackboard>(OBJECT_DB_GET_INSTANCE(scopes[i]));
+			if (scope.is_valid()) {
+				scope->flush_changes();
+			}
+		}
+	}
+	if (change_notification == CHANGE_NOTIFICATION_DISABLED) {
+		return;
+	}
+	_poll_bound_vars();
+	if (pending_changes.is_empty()) {
+		return;
+	}
+	// Handlers may write to the blackboard - these changes go to the next batch.
+	Vector<StringName> changes;
+	changes.resize(pending_changes.size());
+	int idx = 0;
+	for (const StringName &name : pending_changes) {
+		changes.set(idx, name);
+		idx += 1;
+	}
+	pending_changes.clear();
+	for (int i = 0; i < changes.size(); i++) {
+		emit_signal(LW_NAME(var_changed), changes[i], get_var(changes[i], Variant(), false));
+	}
+}
+
+void Blackboard::flush_scope_changes() {
+	Blackboard *top_bb = this;
+	while (top_bb->parent.is_valid()) {
+		top_bb = top_bb->parent.ptr();
+	}
+	top_bb->flush_changes();
+}
+
+void Blackboard::set_change_notification(ChangeNotification p_mode) {
+	if (change_notification == CHANGE_NOTIFICATION_DEFERRED && p_mode != CHANGE_NOTIFICATION_DEFERRED) {
+		flush_changes();
+	}
+	change_notification = p_mode;
+}
+
+int64_t Blackboard::get_var_version(const StringName &p_name) const {
+	const Blackboard *bb = this;
+	while (bb) {
+		const BBVariable *var = bb->data.getptr(p_name);
+		if (var) {
+			var->poll_bound_value();
+			return var->get_version();
+		}
+		bb = bb->parent.ptr();
+	}
+	return -1;
 }
 
 bool Blackboard::has_var(const StringName &p_name) const {
@@ -151,4 +243,16 @@ void Blackboard::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("bind_var_to_property", "var_name", "object", "property", "create"), &Blackboard::bind_var_to_property, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("unbind_var", "var_name"), &Blackboard::unbind_var);
 	ClassDB::bind_method(D_METHOD("link_var", "var_name", "target_blackboard", "target_var", "create"), &Blackboard::link_var, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_var_version", "var_name"), &Blackboard::get_var_version);
+	ClassDB::bind_method(D_METHOD("set_change_notification", "mode"), &Blackboard::set_change_notification);
+	ClassDB::bind_method(D_METHOD("get_change_notification"), &Blackboard::get_change_notification);
+	ClassDB::bind_method(D_METHOD("flush_changes"), &Blackboard::flush_changes);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "change_notification", PROPERTY_HINT_ENUM, "Disabled,Immediate,Deferred"), "set_change_notification", "get_change_notification");
+
+	BIND_ENUM_CONSTANT(CHANGE_NOTIFICATION_DISABLED);
+	BIND_ENUM_CONSTANT(CHANGE_NOTIFICATION_IMMEDIATE);
+	BIND_ENUM_CONSTANT(CHANGE_NOTIFICATION_DEFERRED);
+
+	ADD_SIGNAL(MethodInfo("var_changed", PropertyInfo(Variant::STRING_NAME, "var_name"), PropertyInfo(Variant::NIL, "value", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NIL_IS_VARIANT)));
 }
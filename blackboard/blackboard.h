@@ -17,6 +17,7 @@
 #ifdef LIMBOAI_MODULE
 #include "core/object/object.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/hash_set.h"
 #include "core/variant/typed_array.h"
 #include "core/variant/variant.h"
 #endif // LIMBOAI_MODULE
@@ -26,6 +27,7 @@
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/core/object.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
 #include <godot_cpp/variant/typed_array.hpp>
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
@@ -33,9 +35,22 @@ using namespace godot;
 class Blackboard : public RefCounted {
 	GDCLASS(Blackboard, RefCounted);
 
+public:
+	enum ChangeNotification : unsigned int {
+		CHANGE_NOTIFICATION_DISABLED, // var_changed is never emitted
+		CHANGE_NOTIFICATION_IMMEDIATE, // emit var_changed on every write
+		CHANGE_NOTIFICATION_DEFERRED, // collect changed variables and emit var_changed in flush_changes()
+	};
+
 private:
 	HashMap<StringName, BBVariable> data;
 	Ref<Blackboard> parent;
+	ChangeNotification change_notification = CHANGE_NOTIFICATION_DISABLED;
+	HashSet<StringName> pending_changes; // Iterated in insertion order.
+	Vector<ObjectID> dirty_scopes; // Child scopes with pending changes, flushed together with the top-most scope. Not owned: scopes already hold their parents.
+
+	void _notify_var_changed(const StringName &p_name, const Variant &p_value);
+	void _poll_bound_vars();
 
 protected:
 	static void _bind_methods();
@@ -68,6 +83,16 @@ public:
 	void assign_var(const StringName &p_name, const BBVariable &p_var);
 
 	void link_var(const StringName &p_name, const Ref<Blackboard> &p_target_blackboard, const StringName &p_target_var, bool p_create = false);
+
+	int64_t get_var_version(const StringName &p_name) const;
+
+	void set_change_notification(ChangeNotification p_mode);
+	ChangeNotification get_change_notification() const { return change_notification; }
+	void flush_changes();
+	// Flushes the top-most scope, which also flushes all child scopes with pending changes.
+	void flush_scope_changes();
 };
 
+VARIANT_ENUM_CAST(Blackboard::ChangeNotification);
+
 #endif // BLACKBOARD_H
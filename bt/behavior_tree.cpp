@@ -12,6 +12,7 @@
 #include "behavior_tree.h"
 #include "tasks/utility/bt_fail.h"
 
+#include "../util/limbo_metrics.h"
 #include "../util/limbo_string_names.h"
 
 #ifdef LIMBOAI_MODULE
@@ -91,6 +92,7 @@ Ref<BTInstance> BehaviorTree::instantiate(Node *p_agent, const Ref<Blackboard> &
 		new_root->set_custom_name("Root task disabled");
 	}
 	new_root->initialize(p_agent, p_blackboard, scene_root);
+	LimboMetrics::count_instantiation();
 	return BTInstance::create(new_root, get_path(), p_instance_owner);
 }
 
@@ -0,0 +1,253 @@
+/**
+ * behavior_tree_generator.cpp
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "behavior_tree_generator.h"
+
+#include "tasks/blackboard/bt_check_var.h"
+#include "tasks/blackboard/bt_set_var.h"
+#include "tasks/composites/bt_dynamic_selector.h"
+#include "tasks/composites/bt_dynamic_sequence.h"
+#include "tasks/composites/bt_parallel.h"
+#include "tasks/composites/bt_random_selector.h"
+#include "tasks/composites/bt_random_sequence.h"
+#include "tasks/composites/bt_selector.h"
+#include "tasks/composites/bt_sequence.h"
+#include "tasks/decorators/bt_always_fail.h"
+#include "tasks/decorators/bt_always_succeed.h"
+#include "tasks/decorators/bt_invert.h"
+#include "tasks/decorators/bt_probability.h"
+#include "tasks/decorators/bt_repeat.h"
+#include "tasks/decorators/bt_subtree.h"
+#include "tasks/decorators/bt_time_limit.h"
+#include "tasks/utility/bt_wait_ticks.h"
+
+void BehaviorTreeGenerator::set_max_depth(int p_max_depth) {
+	ERR_FAIL_COND_MSG(p_max_depth < 0, "BehaviorTreeGenerator: Max depth can't be negative.");
+	max_depth = p_max_depth;
+}
+
+void BehaviorTreeGenerator::set_branching_factor(int p_branching_factor) {
+	ERR_FAIL_COND_MSG(p_branching_factor < 1, "BehaviorTreeGenerator: Branching factor must be at least 1.");
+	branching_factor = p_branching_factor;
+}
+
+Ref<BlackboardPlan> BehaviorTreeGenerator::_create_plan() const {
+	Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+	for (int i = 0; i < blackboard_size; i++) {
+		BBVariable var(Variant::INT);
+		var.set_value(0);
+		plan->add_var(vformat("var_%d", i), var);
+	}
+	return plan;
+}
+
+BehaviorTreeGenerator::TaskKind BehaviorTreeGenerator::_pick_kind(bool p_leaf_only) {
+	double weights[4] = {
+		p_leaf_only ? 0.0 : composite_weight,
+		p_leaf_only ? 0.0 : decorator_weight,
+		action_weight,
+		blackboard_size > 0 ? condition_weight : 0.0,
+	};
+	double total = 0.0;
+	for (double w : weights) {
+		total += w;
+	}
+	if (total <= 0.0) {
+		return KIND_ACTION;
+	}
+	double r = rng->randf() * total;
+	for (int i = 0; i < 4; i++) {
+		if (r < weights[i]) {
+			return (TaskKind)i;
+		}
+		r -= weights[i];
+	}
+	return KIND_ACTION;
+}
+
+StringName BehaviorTreeGenerator::_pick_var() {
+	return vformat("var_%d", rng->randi_range(0, blackboard_size - 1));
+}
+
+Ref<BTTask> BehaviorTreeGenerator::_create_composite() {
+	switch (rng->randi_range(0, 6)) {
+		case 0:
+			return memnew(BTSequence);
+		case 1:
+			return memnew(BTSelector);
+		case 2:
+			return memnew(BTParallel);
+		case 3:
+			return memnew(BTDynamicSequence);
+		case 4:
+			return memnew(BTDynamicSelector);
+		case 5:
+			return memnew(BTRandomSequence);
+		default:
+			return memnew(BTRandomSelector);
+	}
+}
+
+Ref<BTTask> BehaviorTreeGenerator::_create_decorator() {
+	switch (rng->randi_range(0, 5)) {
+		case 0:
+			return memnew(BTInvert);
+		case 1:
+			return memnew(BTAlwaysSucceed);
+		case 2:
+			return memnew(BTAlwaysFail);
+		case 3: {
+			Ref<BTRepeat> repeat = memnew(BTRepeat);
+			repeat->set_times(rng->randi_range(1, 3));
+			return repeat;
+		}
+		case 4: {
+			Ref<BTProbability> probability = memnew(BTProbability);
+			probability->set_run_chance(rng->randf_range(0.5, 1.0));
+			return probability;
+		}
+		default: {
+			Ref<BTTimeLimit> time_limit = memnew(BTTimeLimit);
+			time_limit->set_time_limit(rng->randf_range(1.0, 5.0));
+			return time_limit;
+		}
+	}
+}
+
+Ref<BTTask> BehaviorTreeGenerator::_create_action() {
+	if (blackboard_size > 0 && rng->randf() < 0.5) {
+		Ref<BTSetVar> set_var = memnew(BTSetVar);
+		set_var->set_variable(_pick_var());
+		set_var->set_value(memnew(BBVariant(rng->randi_range(0, 9))));
+		return set_var;
+	}
+	Ref<BTWaitTicks> wait = memnew(BTWaitTicks);
+	wait->set_num_ticks(rng->randi_range(1, 3));
+	return wait;
+}
+
+Ref<BTTask> BehaviorTreeGenerator::_create_condition() {
+	Ref<BTCheckVar> check_var = memnew(BTCheckVar);
+	check_var->set_variable(_pick_var());
+	check_var->set_check_type((LimboUtility::CheckType)rng->randi_range(0, LimboUtility::CHECK_NOT_EQUAL));
+	check_var->set_value(memnew(BBVariant(rng->randi_range(0, 9))));
+	return check_var;
+}
+
+Ref<BTTask> BehaviorTreeGenerator::_generate_task(int p_depth, int p_max_depth, bool p_allow_subtrees) {
+	if (p_allow_subtrees && !subtrees.is_empty() && p_depth > 0 && rng->randf() < subtree_chance) {
+		Ref<BTSubtree> subtree = memnew(BTSubtree);
+		subtree->set_subtree(subtrees[rng->randi_range(0, subtrees.size() - 1)]);
+		return subtree;
+	}
+
+	switch (_pick_kind(p_depth >= p_max_depth)) {
+		case KIND_COMPOSITE: {
+			Ref<BTTask> composite = _create_composite();
+			for (int i = 0; i < branching_factor; i++) {
+				composite->add_child(_generate_task(p_depth + 1, p_max_depth, p_allow_subtrees));
+			}
+			return composite;
+		}
+		case KIND_DECORATOR: {
+			Ref<BTTask> decorator = _create_decorator();
+			decorator->add_child(_generate_task(p_depth + 1, p_max_depth, p_allow_subtrees));
+			return decorator;
+		}
+		case KIND_CONDITION: {
+			return _create_condition();
+		}
+		default: {
+			return _create_action();
+		}
+	}
+}
+
+Ref<BehaviorTree> BehaviorTreeGenerator::generate() {
+	rng->set_seed(seed);
+	subtrees.clear();
+
+	// Shared subtrees are generated first, so that they can be referenced from many places in the main tree.
+	for (int i = 0; i < subtree_count; i++) {
+		Ref<BehaviorTree> subtree = memnew(BehaviorTree);
+		subtree->set_description(vformat("Generated subtree %d", i));
+		subtree->set_blackboard_plan(_create_plan());
+		subtree->set_root_task(_generate_task(0, subtree_depth, false));
+		subtrees.push_back(subtree);
+	}
+
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	bt->set_description(vformat("Generated with seed %d", seed));
+	bt->set_blackboard_plan(_create_plan());
+	// Root is always a composite, so that even tiny configurations produce a tree worth ticking.
+	Ref<BTTask> root = _create_composite();
+	for (int i = 0; i < branching_factor; i++) {
+		root->add_child(_generate_task(1, max_depth, true));
+	}
+	bt->set_root_task(root);
+
+	subtrees.clear();
+	return bt;
+}
+
+int BehaviorTreeGenerator::get_task_count(const Ref<BTTask> &p_task) {
+	ERR_FAIL_COND_V(p_task.is_null(), 0);
+	int count = 1;
+	for (int i = 0; i < p_task->get_child_count(); i++) {
+		count += get_task_count(p_task->get_child(i));
+	}
+	return count;
+}
+
+void BehaviorTreeGenerator::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_seed", "seed"), &BehaviorTreeGenerator::set_seed);
+	ClassDB::bind_method(D_METHOD("get_seed"), &BehaviorTreeGenerator::get_seed);
+	ClassDB::bind_method(D_METHOD("set_max_depth", "max_depth"), &BehaviorTreeGenerator::set_max_depth);
+	ClassDB::bind_method(D_METHOD("get_max_depth"), &BehaviorTreeGenerator::get_max_depth);
+	ClassDB::bind_method(D_METHOD("set_branching_factor", "branching_factor"), &BehaviorTreeGenerator::set_branching_factor);
+	ClassDB::bind_method(D_METHOD("get_branching_factor"), &BehaviorTreeGenerator::get_branching_factor);
+	ClassDB::bind_method(D_METHOD("set_composite_weight", "weight"), &BehaviorTreeGenerator::set_composite_weight);
+	ClassDB::bind_method(D_METHOD("get_composite_weight"), &BehaviorTreeGenerator::get_composite_weight);
+	ClassDB::bind_method(D_METHOD("set_decorator_weight", "weight"), &BehaviorTreeGenerator::set_decorator_weight);
+	ClassDB::bind_method(D_METHOD("get_decorator_weight"), &BehaviorTreeGenerator::get_decorator_weight);
+	ClassDB::bind_method(D_METHOD("set_action_weight", "weight"), &BehaviorTreeGenerator::set_action_weight);
+	ClassDB::bind_method(D_METHOD("get_action_weight"), &BehaviorTreeGenerator::get_action_weight);
+	ClassDB::bind_method(D_METHOD("set_condition_weight", "weight"), &BehaviorTreeGenerator::set_condition_weight);
+	ClassDB::bind_method(D_METHOD("get_condition_weight"), &BehaviorTreeGenerator::get_condition_weight);
+	ClassDB::bind_method(D_METHOD("set_blackboard_size", "size"), &BehaviorTreeGenerator::set_blackboard_size);
+	ClassDB::bind_method(D_METHOD("get_blackboard_size"), &BehaviorTreeGenerator::get_blackboard_size);
+	ClassDB::bind_method(D_METHOD("set_subtree_count", "count"), &BehaviorTreeGenerator::set_subtree_count);
+	ClassDB::bind_method(D_METHOD("get_subtree_count"), &BehaviorTreeGenerator::get_subtree_count);
+	ClassDB::bind_method(D_METHOD("set_subtree_depth", "depth"), &BehaviorTreeGenerator::set_subtree_depth);
+	ClassDB::bind_method(D_METHOD("get_subtree_depth"), &BehaviorTreeGenerator::get_subtree_depth);
+	ClassDB::bind_method(D_METHOD("set_subtree_chance", "chance"), &BehaviorTreeGenerator::set_subtree_chance);
+	ClassDB::bind_method(D_METHOD("get_subtree_chance"), &BehaviorTreeGenerator::get_subtree_chance);
+	ClassDB::bind_method(D_METHOD("generate"), &BehaviorTreeGenerator::generate);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "seed"), "set_seed", "get_seed");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_depth", PROPERTY_HINT_RANGE, "0,32,1,or_greater"), "set_max_depth", "get_max_depth");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "branching_factor", PROPERTY_HINT_RANGE, "1,32,1,or_greater"), "set_branching_factor", "get_branching_factor");
+	ADD_GROUP("Task Mix", "");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "composite_weight", PROPERTY_HINT_RANGE, "0,10,0.01,or_greater"), "set_composite_weight", "get_composite_weight");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "decorator_weight", PROPERTY_HINT_RANGE, "0,10,0.01,or_greater"), "set_decorator_weight", "get_decorator_weight");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "action_weight", PROPERTY_HINT_RANGE, "0,10,0.01,or_greater"), "set_action_weight", "get_action_weight");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "condition_weight", PROPERTY_HINT_RANGE, "0,10,0.01,or_greater"), "set_condition_weight", "get_condition_weight");
+	ADD_GROUP("Blackboard", "");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "blackboard_size", PROPERTY_HINT_RANGE, "0,256,1,or_greater"), "set_blackboard_size", "get_blackboard_size");
+	ADD_GROUP("Subtrees", "subtree_");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "subtree_count", PROPERTY_HINT_RANGE, "0,64,1,or_greater"), "set_subtree_count", "get_subtree_count");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "subtree_depth", PROPERTY_HINT_RANGE, "0,32,1,or_greater"), "set_subtree_depth", "get_subtree_depth");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "subtree_chance", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_subtree_chance", "get_subtree_chance");
+}
+
+BehaviorTreeGenerator::BehaviorTreeGenerator() {
+	rng.instantiate();
+}
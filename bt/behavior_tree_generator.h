@@ -0,0 +1,109 @@
+/**
+ * behavior_tree_generator.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef BEHAVIOR_TREE_GENERATOR_H
+#define BEHAVIOR_TREE_GENERATOR_H
+
+#include "behavior_tree.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/math/random_number_generator.h"
+#include "core/object/ref_counted.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/random_number_generator.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+// Builds random but valid behavior trees for stress testing and benchmarks.
+// The same parameters and seed always produce the same tree.
+class BehaviorTreeGenerator : public RefCounted {
+	GDCLASS(BehaviorTreeGenerator, RefCounted);
+
+private:
+	enum TaskKind {
+		KIND_COMPOSITE,
+		KIND_DECORATOR,
+		KIND_ACTION,
+		KIND_CONDITION,
+	};
+
+	int64_t seed = 0;
+	int max_depth = 4;
+	int branching_factor = 3;
+	double composite_weight = 1.0;
+	double decorator_weight = 0.3;
+	double action_weight = 1.0;
+	double condition_weight = 0.5;
+	int blackboard_size = 8;
+	int subtree_count = 0;
+	int subtree_depth = 2;
+	double subtree_chance = 0.1;
+
+	Ref<RandomNumberGenerator> rng;
+	Vector<Ref<BehaviorTree>> subtrees;
+
+	Ref<BlackboardPlan> _create_plan() const;
+	TaskKind _pick_kind(bool p_leaf_only);
+	StringName _pick_var();
+	Ref<BTTask> _generate_task(int p_depth, int p_max_depth, bool p_allow_subtrees);
+	Ref<BTTask> _create_composite();
+	Ref<BTTask> _create_decorator();
+	Ref<BTTask> _create_action();
+	Ref<BTTask> _create_condition();
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_seed(int64_t p_seed) { seed = p_seed; }
+	int64_t get_seed() const { return seed; }
+
+	void set_max_depth(int p_max_depth);
+	int get_max_depth() const { return max_depth; }
+
+	void set_branching_factor(int p_branching_factor);
+	int get_branching_factor() const { return branching_factor; }
+
+	void set_composite_weight(double p_weight) { composite_weight = MAX(0.0, p_weight); }
+	double get_composite_weight() const { return composite_weight; }
+
+	void set_decorator_weight(double p_weight) { decorator_weight = MAX(0.0, p_weight); }
+	double get_decorator_weight() const { return decorator_weight; }
+
+	void set_action_weight(double p_weight) { action_weight = MAX(0.0, p_weight); }
+	double get_action_weight() const { return action_weight; }
+
+	void set_condition_weight(double p_weight) { condition_weight = MAX(0.0, p_weight); }
+	double get_condition_weight() const { return condition_weight; }
+
+	void set_blackboard_size(int p_size) { blackboard_size = MAX(0, p_size); }
+	int get_blackboard_size() const { return blackboard_size; }
+
+	void set_subtree_count(int p_count) { subtree_count = MAX(0, p_count); }
+	int get_subtree_count() const { return subtree_count; }
+
+	void set_subtree_depth(int p_depth) { subtree_depth = MAX(0, p_depth); }
+	int get_subtree_depth() const { return subtree_depth; }
+
+	void set_subtree_chance(double p_chance) { subtree_chance = CLAMP(p_chance, 0.0, 1.0); }
+	double get_subtree_chance() const { return subtree_chance; }
+
+	Ref<BehaviorTree> generate();
+
+	static int get_task_count(const Ref<BTTask> &p_task);
+
+	BehaviorTreeGenerator();
+};
+
+#endif // BEHAVIOR_TREE_GENERATOR_H
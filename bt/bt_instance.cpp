@@ -13,19 +13,30 @@
 
 #include "../compat/object.h"
 #include "../compat/performance.h"
+#include "../compat/variant.h"
 #include "../editor/debugger/limbo_debugger.h"
+#include "../util/limbo_metrics.h"
+#include "../util/limbo_profiler.h"
 #include "../util/limbo_string_names.h"
 
 #ifdef LIMBOAI_MODULE
+#include "core/config/engine.h"
+#include "core/io/file_access.h"
 #include "core/os/time.h"
 #include "main/performance.h"
 #endif
 
 #ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/file_access.hpp>
 #include <godot_cpp/classes/performance.hpp>
 #include <godot_cpp/classes/time.hpp>
 #endif
 
+#ifdef DEBUG_ENABLED
+HashMap<String, BTInstance::TreeMonitor *> BTInstance::tree_monitors;
+#endif
+
 Node *BTInstance::get_owner_node() const {
 	return owner_node_id ? Object::cast_to<Node>(OBJECT_DB_GET_INSTANCE(owner_node_id)) : nullptr;
 }
@@ -38,35 +49,184 @@ Ref<BTInstance> BTInstance::create(Ref<BTTask> p_root_task, String p_source_bt_p
 	inst->root_task = p_root_task;
 	inst->owner_node_id = p_owner_node->get_instance_id();
 	inst->source_bt_path = p_source_bt_path;
+	p_root_task->data.instance_id = inst->get_instance_id();
 	return inst;
 }
 
+void BTInstance::_save_task_state(const BTTask *p_task, PackedInt32Array &r_status, PackedFloat64Array &r_elapsed, Array &r_runtime) {
+	r_status.push_back(p_task->data.status);
+	r_elapsed.push_back(p_task->data.elapsed);
+	r_runtime.push_back(p_task->_get_runtime_state());
+	for (int i = 0; i < p_task->data.children.size(); i++) {
+		_save_task_state(p_task->data.children[i].ptr(), r_status, r_elapsed, r_runtime);
+	}
+}
+
+void BTInstance::_load_task_state(BTTask *p_task, const int32_t *p_status, const double *p_elapsed, const Array &p_runtime, int &r_idx) {
+	p_task->data.status = (BT::Status)p_status[r_idx];
+	p_task->data.elapsed = p_elapsed[r_idx];
+	p_task->_set_runtime_state(p_runtime[r_idx]);
+	r_idx += 1;
+	for (int i = 0; i < p_task->data.children.size(); i++) {
+		_load_task_state(p_task->data.children[i].ptr(), p_status, p_elapsed, p_runtime, r_idx);
+	}
+}
+
+int BTInstance::_get_task_count(const BTTask *p_task) {
+	int count = 1;
+	for (int i = 0; i < p_task->data.children.size(); i++) {
+		count += _get_task_count(p_task->data.children[i].ptr());
+	}
+	return count;
+}
+
+void BTInstance::save_snapshot(Array &r_data) const {
+	ERR_FAIL_COND(root_task.is_null());
+	PackedInt32Array status;
+	PackedFloat64Array elapsed;
+	Array runtime;
+	_save_task_state(root_task.ptr(), status, elapsed, runtime);
+	r_data.push_back(last_status);
+	r_data.push_back(status);
+	r_data.push_back(elapsed);
+	r_data.push_back(runtime);
+	r_data.push_back(rng.is_valid() ? Variant(rng->get_state()) : Variant());
+}
+
+bool BTInstance::load_snapshot(const Array &p_data, int &r_pos) {
+	ERR_FAIL_COND_V(root_task.is_null(), false);
+	ERR_FAIL_COND_V_MSG(r_pos + 5 > p_data.size(), false, "BTInstance: Snapshot data is truncated.");
+	PackedInt32Array status = p_data[r_pos + 1];
+	PackedFloat64Array elapsed = p_data[r_pos + 2];
+	Array runtime = p_data[r_pos + 3];
+	ERR_FAIL_COND_V_MSG(status.size() != _get_task_count(root_task.ptr()) || elapsed.size() != status.size() || runtime.size() != status.size(), false, "BTInstance: Snapshot doesn't match the behavior tree structure.");
+
+	last_status = (BT::Status)(int)p_data[r_pos];
+	int idx = 0;
+	_load_task_state(root_task.ptr(), status.ptr(), elapsed.ptr(), runtime, idx);
+	if (p_data[r_pos + 4].get_type() == Variant::NIL) {
+		// The RNG wasn't used yet when the snapshot was taken.
+		rng.unref();
+		root_task->_set_rng(rng);
+	} else {
+		get_rng()->set_state(p_data[r_pos + 4]);
+	}
+	r_pos += 5;
+	return true;
+}
+
+Ref<RandomNumberGenerator> BTInstance::get_rng() {
+	if (rng.is_null()) {
+		rng.instantiate();
+		if (root_task.is_valid()) {
+			root_task->_set_rng(rng);
+		}
+	}
+	return rng;
+}
+
+void BTInstance::set_rng(const Ref<RandomNumberGenerator> &p_rng) {
+	ERR_FAIL_COND_MSG(p_rng.is_null(), "BTInstance: RNG can't be null.");
+	rng = p_rng;
+	if (root_task.is_valid()) {
+		root_task->_set_rng(rng);
+	}
+}
+
 BT::Status BTInstance::update(double p_delta) {
 	ERR_FAIL_COND_V(!root_task.is_valid(), BT::FRESH);
 
+	// Update time is only measured when something consumes it.
 #ifdef DEBUG_ENABLED
-	double start = Time::get_singleton()->get_ticks_usec();
+	const bool measure_time = true;
+#else
+	const bool measure_time = LimboMetrics::is_frame_time_histogram_enabled() || unlikely(LimboProfiler::is_active());
 #endif
+	const uint64_t start = measure_time ? Time::get_singleton()->get_ticks_usec() : 0;
 
 	const Ref<BTInstance> keep_alive{ this }; // keep instance alive until update is finished
 	last_status = root_task->execute(p_delta);
+	if (unlikely(trace_recorder)) {
+		trace_recorder->record();
+	}
+	if (root_task->get_blackboard().is_valid()) {
+		root_task->get_blackboard()->flush_scope_changes();
+	}
 	emit_signal(LW_NAME(updated), last_status);
 
+	LimboMetrics::count_tick();
+	if (!measure_time) {
+		return last_status;
+	}
+	const uint64_t update_time = Time::get_singleton()->get_ticks_usec() - start;
+	if (LimboMetrics::is_frame_time_histogram_enabled()) {
+		LimboMetrics::add_update_time(update_time);
+	}
+	if (unlikely(LimboProfiler::is_active())) {
+		Node *owner_node = get_owner_node();
+		LimboProfiler::add_span("bt", vformat("%s (%s)", source_bt_path.get_file(), owner_node ? String(owner_node->get_name()) : String()), start, start + update_time);
+	}
 #ifdef DEBUG_ENABLED
-	double end = Time::get_singleton()->get_ticks_usec();
-	update_time_acc += (end - start);
+	update_time_acc += update_time;
 	update_time_n += 1.0;
+	if (tree_monitor) {
+		tree_monitor->update_time_acc += update_time;
+		tree_monitor->update_time_n += 1.0;
+	}
 #endif
 	return last_status;
 }
 
+void BTInstance::set_trace_capacity(int p_capacity) {
+	ERR_FAIL_COND_MSG(p_capacity < 0, "BTInstance: Trace capacity can't be negative.");
+	ERR_FAIL_COND_MSG(p_capacity > 0 && root_task.is_null(), "BTInstance: Can't record a trace without a root task.");
+	if (p_capacity == 0) {
+		if (trace_recorder) {
+			memdelete(trace_recorder);
+			trace_recorder = nullptr;
+		}
+		return;
+	}
+	if (trace_recorder == nullptr) {
+		trace_recorder = memnew(BTTraceRecorder);
+	}
+	trace_recorder->setup(root_task, p_capacity);
+}
+
+void BTInstance::clear_trace() {
+	if (trace_recorder) {
+		trace_recorder->clear();
+	}
+}
+
+PackedByteArray BTInstance::dump_trace() const {
+	ERR_FAIL_NULL_V_MSG(trace_recorder, PackedByteArray(), "BTInstance: Trace recording is not enabled.");
+	// Tree structure is captured at dump time, so that recording doesn't need task names.
+	Array data;
+	data.push_back(BTTraceRecorder::TRACE_FORMAT_VERSION);
+	data.push_back(BTTraceRecorder::serialize_structure(this));
+	data.push_back(trace_recorder->encode_events());
+	return VARIANT_TO_BYTES(data);
+}
+
+Error BTInstance::save_trace(const String &p_path) const {
+	ERR_FAIL_NULL_V_MSG(trace_recorder, ERR_UNCONFIGURED, "BTInstance: Trace recording is not enabled.");
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), FileAccess::get_open_error(), "BTInstance: Failed to open file for writing: " + p_path);
+	f->store_buffer(dump_trace());
+	return f->get_error();
+}
+
 void BTInstance::set_monitor_performance(bool p_monitor) {
 #ifdef DEBUG_ENABLED
+	if (monitor_performance == p_monitor) {
+		return;
+	}
 	monitor_performance = p_monitor;
 	if (monitor_performance) {
-		_add_custom_monitor();
+		_join_tree_monitor();
 	} else {
-		_remove_custom_monitor();
+		_leave_tree_monitor();
 	}
 #endif
 }
@@ -79,6 +239,25 @@ bool BTInstance::get_monitor_performance() const {
 #endif
 }
 
+void BTInstance::set_monitor_instance_performance(bool p_monitor) {
+#ifdef DEBUG_ENABLED
+	monitor_instance_performance = p_monitor;
+	if (monitor_instance_performance) {
+		_add_custom_monitor();
+	} else {
+		_remove_custom_monitor();
+	}
+#endif
+}
+
+bool BTInstance::get_monitor_instance_performance() const {
+#ifdef DEBUG_ENABLED
+	return monitor_instance_performance;
+#else
+	return false;
+#endif
+}
+
 void BTInstance::register_with_debugger() {
 #ifdef DEBUG_ENABLED
 	if (LimboDebugger::get_singleton()->is_active()) {
@@ -127,6 +306,80 @@ void BTInstance::_remove_custom_monitor() {
 	}
 }
 
+void BTInstance::_join_tree_monitor() {
+	ERR_FAIL_COND(tree_monitor != nullptr);
+
+	TreeMonitor **existing = tree_monitors.getptr(source_bt_path);
+	if (existing) {
+		tree_monitor = *existing;
+	} else {
+		tree_monitor = memnew(TreeMonitor);
+		tree_monitor->sample_frame = Engine::get_singleton()->get_process_frames();
+		String tree_name = source_bt_path.is_empty() ? String("unsaved") : source_bt_path.get_file();
+		String suffix = vformat("%s_%s", tree_name, source_bt_path.md5_text().substr(0, 4));
+		tree_monitor->total_monitor_id = vformat("LimboAI/update_ms|%s", suffix);
+		tree_monitor->mean_monitor_id = vformat("LimboAI/mean_update_ms|%s", suffix);
+		tree_monitor->count_monitor_id = vformat("LimboAI/instances|%s", suffix);
+		tree_monitors.insert(source_bt_path, tree_monitor);
+
+		PERFORMANCE_ADD_CUSTOM_MONITOR(tree_monitor->total_monitor_id, callable_mp_static(&BTInstance::_get_tree_total_update_time_msec).bind(source_bt_path));
+		PERFORMANCE_ADD_CUSTOM_MONITOR(tree_monitor->mean_monitor_id, callable_mp_static(&BTInstance::_get_tree_mean_update_time_msec).bind(source_bt_path));
+		PERFORMANCE_ADD_CUSTOM_MONITOR(tree_monitor->count_monitor_id, callable_mp_static(&BTInstance::_get_tree_instance_count).bind(source_bt_path));
+	}
+	tree_monitor->instance_count += 1;
+}
+
+void BTInstance::_leave_tree_monitor() {
+	if (tree_monitor == nullptr) {
+		return;
+	}
+	tree_monitor->instance_count -= 1;
+	if (tree_monitor->instance_count == 0) {
+		Performance *perf = Performance::get_singleton();
+		if (perf) {
+			perf->remove_custom_monitor(tree_monitor->total_monitor_id);
+			perf->remove_custom_monitor(tree_monitor->mean_monitor_id);
+			perf->remove_custom_monitor(tree_monitor->count_monitor_id);
+		}
+		tree_monitors.erase(source_bt_path);
+		memdelete(tree_monitor);
+	}
+	tree_monitor = nullptr;
+}
+
+BTInstance::TreeMonitor *BTInstance::_sample_tree_monitor(const String &p_bt_path) {
+	TreeMonitor **existing = tree_monitors.getptr(p_bt_path);
+	if (existing == nullptr) {
+		return nullptr;
+	}
+	// Monitors of the same tree are polled together, so accumulated time is sampled once per frame.
+	TreeMonitor *tm = *existing;
+	uint64_t frame = Engine::get_singleton()->get_process_frames();
+	if (frame != tm->sample_frame) {
+		tm->total_update_time_msec = (tm->update_time_acc * 0.001) / double(frame - tm->sample_frame);
+		tm->mean_update_time_msec = tm->update_time_n ? (tm->update_time_acc * 0.001) / tm->update_time_n : 0.0;
+		tm->update_time_acc = 0.0;
+		tm->update_time_n = 0.0;
+		tm->sample_frame = frame;
+	}
+	return tm;
+}
+
+double BTInstance::_get_tree_total_update_time_msec(const String &p_bt_path) {
+	TreeMonitor *tm = _sample_tree_monitor(p_bt_path);
+	return tm ? tm->total_update_time_msec : 0.0;
+}
+
+double BTInstance::_get_tree_mean_update_time_msec(const String &p_bt_path) {
+	TreeMonitor *tm = _sample_tree_monitor(p_bt_path);
+	return tm ? tm->mean_update_time_msec : 0.0;
+}
+
+int BTInstance::_get_tree_instance_count(const String &p_bt_path) {
+	TreeMonitor **existing = tree_monitors.getptr(p_bt_path);
+	return existing ? (*existing)->instance_count : 0;
+}
+
 #endif // * DEBUG_ENABLED
 
 void BTInstance::_bind_methods() {
@@ -139,15 +392,30 @@ void BTInstance::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("is_instance_valid"), &BTInstance::is_instance_valid);
 
+	ClassDB::bind_method(D_METHOD("set_rng", "rng"), &BTInstance::set_rng);
+	ClassDB::bind_method(D_METHOD("get_rng"), &BTInstance::get_rng);
+
 	ClassDB::bind_method(D_METHOD("set_monitor_performance", "monitor"), &BTInstance::set_monitor_performance);
 	ClassDB::bind_method(D_METHOD("get_monitor_performance"), &BTInstance::get_monitor_performance);
+	ClassDB::bind_method(D_METHOD("set_monitor_instance_performance", "monitor"), &BTInstance::set_monitor_instance_performance);
+	ClassDB::bind_method(D_METHOD("get_monitor_instance_performance"), &BTInstance::get_monitor_instance_performance);
 
 	ClassDB::bind_method(D_METHOD("update", "delta"), &BTInstance::update);
 
+	ClassDB::bind_method(D_METHOD("set_trace_capacity", "capacity"), &BTInstance::set_trace_capacity);
+	ClassDB::bind_method(D_METHOD("get_trace_capacity"), &BTInstance::get_trace_capacity);
+	ClassDB::bind_method(D_METHOD("get_trace_event_count"), &BTInstance::get_trace_event_count);
+	ClassDB::bind_method(D_METHOD("clear_trace"), &BTInstance::clear_trace);
+	ClassDB::bind_method(D_METHOD("dump_trace"), &BTInstance::dump_trace);
+	ClassDB::bind_method(D_METHOD("save_trace", "path"), &BTInstance::save_trace);
+
 	ClassDB::bind_method(D_METHOD("register_with_debugger"), &BTInstance::register_with_debugger);
 	ClassDB::bind_method(D_METHOD("unregister_with_debugger"), &BTInstance::unregister_with_debugger);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitor_performance"), "set_monitor_performance", "get_monitor_performance");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitor_instance_performance"), "set_monitor_instance_performance", "get_monitor_instance_performance");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "trace_capacity", PROPERTY_HINT_RANGE, "0,1000000,1,or_greater"), "set_trace_capacity", "get_trace_capacity");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "rng", PROPERTY_HINT_RESOURCE_TYPE, "RandomNumberGenerator", PROPERTY_USAGE_NONE), "set_rng", "get_rng");
 
 	ADD_SIGNAL(MethodInfo("updated", PropertyInfo(Variant::INT, "status")));
 	ADD_SIGNAL(MethodInfo("freed"));
@@ -155,8 +423,12 @@ void BTInstance::_bind_methods() {
 
 BTInstance::~BTInstance() {
 	emit_signal(LW_NAME(freed));
+	if (trace_recorder) {
+		memdelete(trace_recorder);
+	}
 #ifdef DEBUG_ENABLED
 	_remove_custom_monitor();
+	_leave_tree_monitor();
 	unregister_with_debugger();
 #endif
 }
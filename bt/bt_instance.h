@@ -11,6 +11,7 @@
 #ifndef BT_INSTANCE_H
 #define BT_INSTANCE_H
 
+#include "bt_trace_recorder.h"
 #include "tasks/bt_task.h"
 
 class BTInstance : public RefCounted {
@@ -21,9 +22,32 @@ private:
 	uint64_t owner_node_id = 0;
 	String source_bt_path;
 	BT::Status last_status = BT::FRESH;
+	Ref<RandomNumberGenerator> rng; // Created on first use, so trees without random tasks don't pay for it.
+	BTTraceRecorder *trace_recorder = nullptr; // Opt-in, see set_trace_capacity().
+
+	static void _save_task_state(const BTTask *p_task, PackedInt32Array &r_status, PackedFloat64Array &r_elapsed, Array &r_runtime);
+	static void _load_task_state(BTTask *p_task, const int32_t *p_status, const double *p_elapsed, const Array &p_runtime, int &r_idx);
+	static int _get_task_count(const BTTask *p_task);
 
 #ifdef DEBUG_ENABLED
+	// Performance monitors shared by all monitored instances of the same BehaviorTree resource.
+	struct TreeMonitor {
+		int instance_count = 0;
+		double update_time_acc = 0.0;
+		double update_time_n = 0.0;
+		uint64_t sample_frame = 0;
+		double total_update_time_msec = 0.0;
+		double mean_update_time_msec = 0.0;
+		StringName total_monitor_id;
+		StringName mean_monitor_id;
+		StringName count_monitor_id;
+	};
+	static HashMap<String, TreeMonitor *> tree_monitors;
+
 	bool monitor_performance = false;
+	TreeMonitor *tree_monitor = nullptr;
+
+	bool monitor_instance_performance = false;
 	StringName monitor_id;
 	double update_time_acc = 0.0;
 	double update_time_n = 0.0;
@@ -32,6 +56,13 @@ private:
 	void _add_custom_monitor();
 	void _remove_custom_monitor();
 
+	void _join_tree_monitor();
+	void _leave_tree_monitor();
+	static TreeMonitor *_sample_tree_monitor(const String &p_bt_path);
+	static double _get_tree_total_update_time_msec(const String &p_bt_path);
+	static double _get_tree_mean_update_time_msec(const String &p_bt_path);
+	static int _get_tree_instance_count(const String &p_bt_path);
+
 #endif // * DEBUG_ENABLED
 
 protected:
@@ -51,14 +82,32 @@ public:
 
 	_FORCE_INLINE_ bool is_instance_valid() const { return root_task.is_valid(); }
 
+	void set_rng(const Ref<RandomNumberGenerator> &p_rng);
+	Ref<RandomNumberGenerator> get_rng();
+
 	BT::Status update(double p_delta);
 
 	void set_monitor_performance(bool p_monitor);
 	bool get_monitor_performance() const;
 
+	void set_monitor_instance_performance(bool p_monitor);
+	bool get_monitor_instance_performance() const;
+
 	void register_with_debugger();
 	void unregister_with_debugger();
 
+	// Runtime state snapshot: task statuses, elapsed times, internal state of native tasks and RNG state.
+	void save_snapshot(Array &r_data) const;
+	bool load_snapshot(const Array &p_data, int &r_pos);
+
+	// Execution trace: ring buffer of task status transitions, dumpable for offline inspection.
+	void set_trace_capacity(int p_capacity);
+	int get_trace_capacity() const { return trace_recorder ? trace_recorder->get_capacity() : 0; }
+	int get_trace_event_count() const { return trace_recorder ? trace_recorder->get_event_count() : 0; }
+	void clear_trace();
+	PackedByteArray dump_trace() const;
+	Error save_trace(const String &p_path) const;
+
 	static Ref<BTInstance> create(Ref<BTTask> p_root_task, String p_source_bt_path, Node *p_owner_node);
 
 	BTInstance() = default;
@@ -71,6 +71,12 @@ Node *BTState::_get_prefetch_root_for_base_plan() {
 
 void BTState::_setup() {
 	LimboState::_setup();
+	if (!instantiate_on_enter) {
+		_instantiate_bt();
+	}
+}
+
+void BTState::_instantiate_bt() {
 	ERR_FAIL_COND_MSG(behavior_tree.is_null(), "BTState: BehaviorTree is not assigned.");
 	Node *scene_root = _get_scene_root();
 	ERR_FAIL_NULL_MSG(scene_root, "BTState: Initialization failed - unable to establish scene root. This is likely due to BTState not being owned by a scene node. Check BTState.set_scene_root_hint().");
@@ -83,6 +89,32 @@ void BTState::_setup() {
 #endif
 }
 
+void BTState::_release_bt() {
+	if (bt_instance.is_null()) {
+		return;
+	}
+#ifdef DEBUG_ENABLED
+	bt_instance->unregister_with_debugger();
+	bt_instance->set_monitor_performance(false);
+#endif
+	bt_instance.unref();
+}
+
+void BTState::_cancel_release() {
+	if (release_time_left >= 0.0) {
+		release_time_left = -1.0;
+		set_process_internal(false);
+	}
+}
+
+void BTState::_enter() {
+	_cancel_release();
+	if (bt_instance.is_null() && instantiate_on_enter) {
+		_instantiate_bt();
+	}
+	LimboState::_enter();
+}
+
 void BTState::_exit() {
 	if (bt_instance.is_valid()) {
 		bt_instance->get_root_task()->abort();
@@ -90,6 +122,14 @@ void BTState::_exit() {
 		ERR_PRINT_ONCE("BTState: BehaviorTree is not assigned.");
 	}
 	LimboState::_exit();
+
+	if (instantiate_on_enter && release_delay == 0.0) {
+		_release_bt();
+	} else if (instantiate_on_enter && release_delay > 0.0 && is_inside_tree()) {
+		// Counted down in NOTIFICATION_INTERNAL_PROCESS.
+		release_time_left = release_delay;
+		set_process_internal(true);
+	}
 }
 
 void BTState::_update(double p_delta) {
@@ -108,6 +148,37 @@ void BTState::_update(double p_delta) {
 	emit_signal(LW_NAME(updated), p_delta);
 }
 
+void BTState::_save_snapshot(Array &r_data) const {
+	LimboState::_save_snapshot(r_data);
+	r_data.push_back(bt_instance.is_valid());
+	if (bt_instance.is_valid()) {
+		bt_instance->save_snapshot(r_data);
+	}
+}
+
+bool BTState::_load_snapshot(const Array &p_data, int &r_pos) {
+	if (!LimboState::_load_snapshot(p_data, r_pos)) {
+		return false;
+	}
+	ERR_FAIL_COND_V_MSG(r_pos >= p_data.size(), false, "BTState: Snapshot data is truncated.");
+	bool has_instance = p_data[r_pos];
+	r_pos += 1;
+	if (instantiate_on_enter) {
+		// Match the recorded instance lifetime.
+		_cancel_release();
+		if (has_instance && bt_instance.is_null()) {
+			_instantiate_bt();
+		} else if (!has_instance) {
+			_release_bt();
+		}
+	}
+	if (has_instance) {
+		ERR_FAIL_COND_V_MSG(bt_instance.is_null(), false, "BTState: Unable to restore snapshot - behavior tree is not instantiated.");
+		return bt_instance->load_snapshot(p_data, r_pos);
+	}
+	return true;
+}
+
 void BTState::_notification(int p_notification) {
 	switch (p_notification) {
 #ifdef DEBUG_ENABLED
@@ -118,7 +189,18 @@ void BTState::_notification(int p_notification) {
 			}
 		} break;
 #endif // DEBUG_ENABLED
+		case NOTIFICATION_INTERNAL_PROCESS: {
+			release_time_left -= get_process_delta_time();
+			if (release_time_left <= 0.0) {
+				release_time_left = -1.0;
+				set_process_internal(false);
+				if (!is_active()) {
+					_release_bt();
+				}
+			}
+		} break;
 		case NOTIFICATION_EXIT_TREE: {
+			_cancel_release();
 #ifdef DEBUG_ENABLED
 			if (bt_instance.is_valid()) {
 				bt_instance->unregister_with_debugger();
@@ -151,12 +233,19 @@ void BTState::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_monitor_performance", "enable"), &BTState::set_monitor_performance);
 	ClassDB::bind_method(D_METHOD("get_monitor_performance"), &BTState::get_monitor_performance);
 
+	ClassDB::bind_method(D_METHOD("set_instantiate_on_enter", "enable"), &BTState::set_instantiate_on_enter);
+	ClassDB::bind_method(D_METHOD("get_instantiate_on_enter"), &BTState::get_instantiate_on_enter);
+	ClassDB::bind_method(D_METHOD("set_release_delay", "seconds"), &BTState::set_release_delay);
+	ClassDB::bind_method(D_METHOD("get_release_delay"), &BTState::get_release_delay);
+
 	ClassDB::bind_method(D_METHOD("set_scene_root_hint", "scene_root"), &BTState::set_scene_root_hint);
 
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "behavior_tree", PROPERTY_HINT_RESOURCE_TYPE, "BehaviorTree"), "set_behavior_tree", "get_behavior_tree");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "success_event"), "set_success_event", "get_success_event");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "failure_event"), "set_failure_event", "get_failure_event");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitor_performance"), "set_monitor_performance", "get_monitor_performance");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "instantiate_on_enter"), "set_instantiate_on_enter", "get_instantiate_on_enter");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "release_delay", PROPERTY_HINT_RANGE, "-1,3600,0.1,or_greater,suffix:s"), "set_release_delay", "get_release_delay");
 }
 
 BTState::BTState() {
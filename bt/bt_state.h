@@ -27,9 +27,16 @@ private:
 	StringName failure_event;
 	Node *scene_root_hint = nullptr;
 	bool monitor_performance = false;
+	bool instantiate_on_enter = false;
+	double release_delay = -1.0;
+	double release_time_left = -1.0; // Negative if no release is pending.
 
 	_FORCE_INLINE_ Node *_get_scene_root() const { return scene_root_hint ? scene_root_hint : get_owner(); }
 
+	void _instantiate_bt();
+	void _release_bt();
+	void _cancel_release();
+
 protected:
 	static void _bind_methods();
 
@@ -40,9 +47,13 @@ protected:
 	virtual Node *_get_prefetch_root_for_base_plan() override;
 
 	virtual void _setup() override;
+	virtual void _enter() override;
 	virtual void _exit() override;
 	virtual void _update(double p_delta) override;
 
+	virtual void _save_snapshot(Array &r_data) const override;
+	virtual bool _load_snapshot(const Array &p_data, int &r_pos) override;
+
 public:
 	void set_behavior_tree(const Ref<BehaviorTree> &p_value);
 	Ref<BehaviorTree> get_behavior_tree() const { return behavior_tree; }
@@ -58,6 +69,12 @@ public:
 	void set_monitor_performance(bool p_monitor);
 	bool get_monitor_performance() const { return monitor_performance; }
 
+	void set_instantiate_on_enter(bool p_enable) { instantiate_on_enter = p_enable; }
+	bool get_instantiate_on_enter() const { return instantiate_on_enter; }
+
+	void set_release_delay(double p_delay) { release_delay = p_delay; }
+	double get_release_delay() const { return release_delay; }
+
 	void set_scene_root_hint(Node *p_node);
 
 	BTState();
@@ -0,0 +1,128 @@
+/**
+ * bt_trace_recorder.cpp
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "bt_trace_recorder.h"
+
+#include "bt_instance.h"
+
+void BTTraceRecorder::_collect_tasks(const Ref<BTTask> &p_task) {
+	tasks.push_back(p_task);
+	last_status.push_back(p_task->get_status());
+	for (int i = 0; i < p_task->get_child_count(); i++) {
+		_collect_tasks(p_task->get_child(i));
+	}
+}
+
+void BTTraceRecorder::setup(const Ref<BTTask> &p_root_task, int p_capacity) {
+	ERR_FAIL_COND(p_root_task.is_null());
+	ERR_FAIL_COND(p_capacity <= 0);
+	tasks.clear();
+	last_status.clear();
+	_collect_tasks(p_root_task);
+	events.resize(p_capacity);
+	clear();
+}
+
+void BTTraceRecorder::clear() {
+	head = 0;
+	count = 0;
+	tick = 0;
+}
+
+void BTTraceRecorder::record() {
+	const int capacity = events.size();
+	const Ref<BTTask> *task_ptrs = tasks.ptr();
+	uint8_t *statuses = last_status.ptrw();
+	Event *ring = events.ptrw();
+	for (int i = 0; i < tasks.size(); i++) {
+		const uint8_t status = task_ptrs[i]->get_status();
+		if (status == statuses[i]) {
+			continue;
+		}
+		Event &ev = ring[head];
+		ev.tick = tick;
+		ev.header = (uint32_t(i) << 4) | (uint32_t(statuses[i]) << 2) | status;
+		ev.elapsed_time = task_ptrs[i]->get_elapsed_time();
+		statuses[i] = status;
+
+		head = (head + 1) % capacity;
+		count = MIN(count + 1, capacity);
+	}
+	tick += 1;
+}
+
+PackedByteArray BTTraceRecorder::encode_events() const {
+	PackedByteArray bytes;
+	bytes.resize(int64_t(count) * EVENT_SIZE);
+	uint8_t *w = bytes.ptrw();
+	const int capacity = events.size();
+	int idx = (head - count + capacity) % MAX(capacity, 1);
+	for (int i = 0; i < count; i++) {
+		const Event &ev = events[idx];
+		memcpy(w, &ev.tick, sizeof(uint32_t));
+		memcpy(w + 4, &ev.header, sizeof(uint32_t));
+		memcpy(w + 8, &ev.elapsed_time, sizeof(float));
+		w += EVENT_SIZE;
+		idx = (idx + 1) % capacity;
+	}
+	return bytes;
+}
+
+bool BTTraceRecorder::decode_event(const PackedByteArray &p_events, int p_idx, Event &r_event) {
+	ERR_FAIL_COND_V(int64_t(p_idx + 1) * EVENT_SIZE > p_events.size(), false);
+	const uint8_t *r = p_events.ptr() + int64_t(p_idx) * EVENT_SIZE;
+	memcpy(&r_event.tick, r, sizeof(uint32_t));
+	memcpy(&r_event.header, r + 4, sizeof(uint32_t));
+	memcpy(&r_event.elapsed_time, r + 8, sizeof(float));
+	return true;
+}
+
+static void _collect_depth_first(const Ref<BTTask> &p_task, Vector<Ref<BTTask>> &r_tasks) {
+	r_tasks.push_back(p_task);
+	for (int i = 0; i < p_task->get_child_count(); i++) {
+		_collect_depth_first(p_task->get_child(i), r_tasks);
+	}
+}
+
+Vector<Ref<BTTask>> BTTraceRecorder::get_tasks_depth_first(const Ref<BTTask> &p_root) {
+	Vector<Ref<BTTask>> tasks;
+	ERR_FAIL_COND_V(p_root.is_null(), tasks);
+	_collect_depth_first(p_root, tasks);
+	return tasks;
+}
+
+Array BTTraceRecorder::serialize_structure(const BTInstance *p_instance) {
+	Array arr;
+	ERR_FAIL_NULL_V(p_instance, arr);
+	arr.push_back(uint64_t(p_instance->get_instance_id()));
+	arr.push_back(p_instance->get_owner_node() ? p_instance->get_owner_node()->get_path() : NodePath());
+	arr.push_back(p_instance->get_source_bt_path());
+
+	Vector<Ref<BTTask>> flat_tasks = get_tasks_depth_first(p_instance->get_root_task());
+	for (const Ref<BTTask> &task : flat_tasks) {
+		String script_path;
+		if (task->get_script()) {
+			Ref<Resource> s = task->get_script();
+			script_path = s->get_path();
+		}
+
+		arr.push_back(task->get_instance_id());
+		arr.push_back(task->get_task_name());
+		arr.push_back(!task->get_custom_name().is_empty());
+		arr.push_back(task->get_child_count());
+		arr.push_back(task->get_status());
+		arr.push_back(task->get_elapsed_time());
+		arr.push_back(task->get_class());
+		arr.push_back(script_path);
+	}
+
+	return arr;
+}
@@ -0,0 +1,64 @@
+/**
+ * bt_trace_recorder.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef BT_TRACE_RECORDER_H
+#define BT_TRACE_RECORDER_H
+
+#include "tasks/bt_task.h"
+
+class BTInstance;
+
+// Fixed-size ring buffer of task status transitions, recorded after each BTInstance update.
+class BTTraceRecorder {
+public:
+	static constexpr int TRACE_FORMAT_VERSION = 1;
+	// Encoded event: tick as uint32, (task index << 4 | old status << 2 | new status) as uint32, elapsed time as float.
+	static constexpr int EVENT_SIZE = 12;
+
+	struct Event {
+		uint32_t tick = 0;
+		uint32_t header = 0;
+		float elapsed_time = 0.0;
+
+		_FORCE_INLINE_ int get_task_index() const { return header >> 4; }
+		_FORCE_INLINE_ int get_old_status() const { return (header >> 2) & 3; }
+		_FORCE_INLINE_ int get_new_status() const { return header & 3; }
+	};
+
+private:
+	Vector<Event> events;
+	int head = 0; // Next write position.
+	int count = 0;
+	uint32_t tick = 0;
+
+	Vector<Ref<BTTask>> tasks; // Depth-first order, same as get_tasks_depth_first(). Kept alive if removed from the tree.
+	Vector<uint8_t> last_status;
+
+	void _collect_tasks(const Ref<BTTask> &p_task);
+
+public:
+	void setup(const Ref<BTTask> &p_root_task, int p_capacity);
+	void record();
+	void clear();
+
+	_FORCE_INLINE_ int get_capacity() const { return events.size(); }
+	_FORCE_INLINE_ int get_event_count() const { return count; }
+
+	// Events in chronological order, EVENT_SIZE bytes each.
+	PackedByteArray encode_events() const;
+	static bool decode_event(const PackedByteArray &p_events, int p_idx, Event &r_event);
+
+	// Tree structure shared by traces and the debugger: instance header, then 8 fields per task in depth-first order.
+	static Vector<Ref<BTTask>> get_tasks_depth_first(const Ref<BTTask> &p_root);
+	static Array serialize_structure(const BTInstance *p_instance);
+};
+
+#endif // BT_TRACE_RECORDER_H
@@ -11,20 +11,26 @@
 
 #include "bt_task.h"
 
+#include "../../compat/math.h"
 #include "../../compat/object.h"
 #include "../../compat/print.h"
+#include "../../util/limbo_metrics.h"
+#include "../../util/limbo_profiler.h"
 #include "../../util/limbo_string_names.h"
 #include "../behavior_tree.h"
+#include "../bt_instance.h"
 
 #ifdef LIMBOAI_MODULE
 #include "core/config/engine.h"
 #include "core/object/script_language.h"
+#include "core/os/time.h"
 #include "core/templates/hash_map.h"
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/script.hpp>
+#include <godot_cpp/classes/time.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
 #endif // LIMBOAI_GDEXTENSION
 
@@ -105,6 +111,59 @@ void BTTask::_set_children(Array p_children) {
 	}
 }
 
+void BTTask::_set_rng(const Ref<RandomNumberGenerator> &p_rng) {
+	data.rng = p_rng;
+	for (int i = 0; i < data.children.size(); i++) {
+		data.children[i]->_set_rng(p_rng);
+	}
+}
+
+RandomNumberGenerator *BTTask::_get_rng() const {
+	if (likely(data.rng.is_valid())) {
+		return data.rng.ptr();
+	}
+	// The instance creates its RNG stream on first use and assigns it to all tasks.
+	const BTTask *root = this;
+	while (root->data.parent != nullptr) {
+		root = root->data.parent;
+	}
+	BTInstance *inst = root->data.instance_id.is_valid() ? Object::cast_to<BTInstance>(ObjectDB::get_instance(root->data.instance_id)) : nullptr;
+	return inst ? inst->get_rng().ptr() : nullptr;
+}
+
+double BTTask::_randf() const {
+	RandomNumberGenerator *rng = _get_rng();
+	if (rng) {
+		return rng->randf();
+	}
+	return RANDF();
+}
+
+double BTTask::_randf_range(double p_from, double p_to) const {
+	RandomNumberGenerator *rng = _get_rng();
+	if (rng) {
+		return rng->randf_range(p_from, p_to);
+	}
+	return RAND_RANGE(p_from, p_to);
+}
+
+int64_t BTTask::_randi_range(int64_t p_from, int64_t p_to) const {
+	RandomNumberGenerator *rng = _get_rng();
+	if (rng) {
+		return rng->randi_range(p_from, p_to);
+	}
+	return RANDI_RANGE(p_from, p_to);
+}
+
+void BTTask::_shuffle_indices(Vector<int> &r_indices) const {
+	// Fisher-Yates shuffle.
+	int *ptr = r_indices.ptrw();
+	for (int i = r_indices.size() - 1; i > 0; i--) {
+		int j = _randi_range(0, i);
+		SWAP(ptr[i], ptr[j]);
+	}
+}
+
 void BTTask::set_enabled(bool p_enabled) {
 	data.enabled = p_enabled;
 	_emit_branch_changed();
@@ -243,6 +302,9 @@ Ref<BTTask> BTTask::clone() const {
 }
 
 BT::Status BTTask::execute(double p_delta) {
+	LimboMetrics::count_task_executed();
+	uint64_t profile_start = unlikely(LimboProfiler::is_active()) ? Time::get_singleton()->get_ticks_usec() : 0;
+
 	if (data.status != RUNNING) {
 		// Reset children status.
 		if (data.status != FRESH) {
@@ -267,6 +329,14 @@ BT::Status BTTask::execute(double p_delta) {
 		_exit();
 		data.elapsed = 0.0;
 	}
+
+	if (unlikely(profile_start)) {
+		// Only spans above the threshold are recorded to keep captures small.
+		uint64_t profile_end = Time::get_singleton()->get_ticks_usec();
+		if (profile_end - profile_start >= LimboProfiler::get_task_threshold()) {
+			LimboProfiler::add_span("task", get_task_name(), profile_start, profile_end);
+		}
+	}
 	return data.status;
 }
 
@@ -444,6 +514,7 @@ void BTTask::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_get_children"), &BTTask::_get_children);
 	ClassDB::bind_method(D_METHOD("_set_children", "children"), &BTTask::_set_children);
 	ClassDB::bind_method(D_METHOD("get_blackboard"), &BTTask::get_blackboard);
+	ClassDB::bind_method(D_METHOD("get_rng"), &BTTask::get_rng);
 	ClassDB::bind_method(D_METHOD("get_parent"), &BTTask::get_parent);
 	ClassDB::bind_method(D_METHOD("get_status"), &BTTask::get_status);
 	ClassDB::bind_method(D_METHOD("get_elapsed_time"), &BTTask::get_elapsed_time);
@@ -454,6 +525,7 @@ void BTTask::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "agent", PROPERTY_HINT_RESOURCE_TYPE, "Node", PROPERTY_USAGE_NONE), "set_agent", "get_agent");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "scene_root", PROPERTY_HINT_NODE_TYPE, "Node", PROPERTY_USAGE_NONE), "", "get_scene_root");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "blackboard", PROPERTY_HINT_RESOURCE_TYPE, "Blackboard", PROPERTY_USAGE_NONE), "", "get_blackboard");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "rng", PROPERTY_HINT_RESOURCE_TYPE, "RandomNumberGenerator", PROPERTY_USAGE_NONE), "", "get_rng");
 	ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "children", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL), "_set_children", "_get_children");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "status", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE), "", "get_status");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "elapsed_time", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE), "", "get_elapsed_time");
@@ -17,6 +17,7 @@
 
 #ifdef LIMBOAI_MODULE
 #include "core/io/resource.h"
+#include "core/math/random_number_generator.h"
 #include "core/object/object.h"
 #include "core/templates/vector.h"
 #include "scene/main/node.h"
@@ -24,6 +25,7 @@
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/random_number_generator.hpp>
 #include <godot_cpp/classes/resource.hpp>
 #include <godot_cpp/core/gdvirtual.gen.inc>
 #include <godot_cpp/core/object.hpp>
@@ -60,6 +62,7 @@ class BTTask : public BT {
 
 private:
 	friend class BehaviorTree;
+	friend class BTInstance;
 
 	// Avoid namespace pollution in the derived classes.
 	struct Data {
@@ -68,6 +71,8 @@ private:
 		Node *agent = nullptr;
 		Node *scene_root = nullptr;
 		Ref<Blackboard> blackboard;
+		Ref<RandomNumberGenerator> rng; // Assigned on first use, see _get_rng().
+		ObjectID instance_id; // Set on the root task of a BTInstance.
 		BTTask *parent = nullptr;
 		Vector<Ref<BTTask>> children;
 		Status status = FRESH;
@@ -84,18 +89,32 @@ private:
 
 	PackedStringArray _get_configuration_warnings(); // ! Scripts only.
 
+	void _set_rng(const Ref<RandomNumberGenerator> &p_rng);
+	RandomNumberGenerator *_get_rng() const;
+
 protected:
 	static void _bind_methods();
 
 	void _set_enabled(bool p_enabled) { data.enabled = p_enabled; }
 	void _emit_branch_changed();
 
+	// Random helpers draw from the BTInstance's RNG stream, or from the global RNG if the task isn't part of an instance.
+	double _randf() const;
+	double _randf_range(double p_from, double p_to) const;
+	int64_t _randi_range(int64_t p_from, int64_t p_to) const;
+	void _shuffle_indices(Vector<int> &r_indices) const;
+
 	virtual String _generate_name();
 	virtual void _setup() {}
 	virtual void _enter() {}
 	virtual void _exit() {}
 	virtual Status _tick(double p_delta) { return FAILURE; }
 
+	// Internal state that status and elapsed time don't cover, such as the index of a running child.
+	// Saved and restored by BTInstance snapshots.
+	virtual Variant _get_runtime_state() const { return Variant(); }
+	virtual void _set_runtime_state(const Variant &p_state) {}
+
 	GDVIRTUAL0RC(String, _generate_name);
 	GDVIRTUAL0(_setup);
 	GDVIRTUAL0(_enter);
@@ -143,6 +162,7 @@ public:
 	_FORCE_INLINE_ Ref<BTTask> get_parent() const { return Ref<BTTask>(data.parent); }
 	_FORCE_INLINE_ bool is_root() const { return data.parent == nullptr; }
 	_FORCE_INLINE_ Ref<Blackboard> get_blackboard() const { return data.blackboard; }
+	_FORCE_INLINE_ Ref<RandomNumberGenerator> get_rng() const { return Ref<RandomNumberGenerator>(_get_rng()); }
 	_FORCE_INLINE_ Status get_status() const { return data.status; }
 	_FORCE_INLINE_ double get_elapsed_time() const { return data.elapsed; };
 
@@ -32,3 +32,11 @@ BT::Status BTDynamicSelector::_tick(double p_delta) {
 	last_running_idx = i;
 	return status;
 }
+
+Variant BTDynamicSelector::_get_runtime_state() const {
+	return last_running_idx;
+}
+
+void BTDynamicSelector::_set_runtime_state(const Variant &p_state) {
+	last_running_idx = p_state;
+}
@@ -26,6 +26,8 @@ protected:
 
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual Variant _get_runtime_state() const override;
+	virtual void _set_runtime_state(const Variant &p_state) override;
 };
 
 #endif // BT_DYNAMIC_SELECTOR_H
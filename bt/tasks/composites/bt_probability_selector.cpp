@@ -11,8 +11,6 @@
 
 #include "bt_probability_selector.h"
 
-#include "../../../compat/math.h"
-
 double BTProbabilitySelector::get_weight(int p_index) const {
 	ERR_FAIL_INDEX_V(p_index, get_child_count(), 0.0);
 	ERR_FAIL_COND_V(!get_child(p_index)->is_enabled(), 0.0);
@@ -62,23 +60,34 @@ bool BTProbabilitySelector::get_abort_on_failure() const {
 	return abort_on_failure;
 }
 
+void BTProbabilitySelector::_setup() {
+	weights_dirty = true;
+}
+
 void BTProbabilitySelector::_enter() {
+	has_failures = false;
+	failed_children.clear();
+	if (!_is_table_valid()) {
+		// Children were added, removed, reordered, enabled or disabled.
+		weights_dirty = true;
+	}
 	_select_task();
 }
 
 void BTProbabilitySelector::_exit() {
-	failed_tasks.clear();
-	selected_task.unref();
+	has_failures = false;
+	failed_children.clear();
+	selected_idx = -1;
 }
 
 BT::Status BTProbabilitySelector::_tick(double p_delta) {
-	while (selected_task.is_valid()) {
-		Status status = selected_task->execute(p_delta);
+	while (selected_idx != -1) {
+		Status status = get_child(selected_idx)->execute(p_delta);
 		if (status == FAILURE) {
 			if (abort_on_failure) {
 				return FAILURE;
 			}
-			failed_tasks.insert(selected_task);
+			_remove_failed(selected_idx);
 			_select_task();
 		} else { // RUNNING or SUCCESS
 			return status;
@@ -88,32 +97,134 @@ BT::Status BTProbabilitySelector::_tick(double p_delta) {
 	return FAILURE;
 }
 
-void BTProbabilitySelector::_select_task() {
-	selected_task.unref();
+Variant BTProbabilitySelector::_get_runtime_state() const {
+	PackedInt32Array failed;
+	failed.resize(failed_children.size());
+	for (int i = 0; i < failed_children.size(); i++) {
+		failed.set(i, failed_children[i]);
+	}
+	Array state;
+	state.push_back(selected_idx);
+	state.push_back(failed);
+	return state;
+}
+
+void BTProbabilitySelector::_set_runtime_state(const Variant &p_state) {
+	Array state = p_state;
+	ERR_FAIL_COND(state.size() != 2);
+	selected_idx = state[0];
+	PackedInt32Array failed = state[1];
+	failed_children.resize(failed.size());
+	for (int i = 0; i < failed.size(); i++) {
+		failed_children.set(i, failed[i]);
+	}
+	has_failures = !failed_children.is_empty();
+	// Rebuilds the remaining candidates from the failed children.
+	_update_table();
+}
+
+void BTProbabilitySelector::_build_cumulative(SelectionTable &r_table, const Vector<double> &p_weights) {
+	const int num_candidates = r_table.candidates.size();
+	r_table.cumulative.resize(num_candidates);
+	const int *candidates = r_table.candidates.ptr();
+	const double *w = p_weights.ptr();
+	double *cumulative = r_table.cumulative.ptrw();
+	double total = 0.0;
+	for (int i = 0; i < num_candidates; i++) {
+		total += w[candidates[i]];
+		cumulative[i] = total;
+	}
+}
 
-	double remaining_tasks_weight = _get_total_weight();
-	for (const Ref<BTTask> &task : failed_tasks) {
-		remaining_tasks_weight -= _get_weight(task);
+void BTProbabilitySelector::_swap_out(SelectionTable &r_table, int p_child_idx) {
+	int pos = r_table.candidates.find(p_child_idx);
+	if (pos != -1) {
+		int last = r_table.candidates.size() - 1;
+		r_table.candidates.set(pos, r_table.candidates[last]);
+		r_table.candidates.resize(last);
 	}
+}
 
-	double roll = RAND_RANGE(0.0, remaining_tasks_weight);
-	for (int i = 0; i < get_child_count(); i++) {
-		Ref<BTTask> task = get_child(i);
-		if (failed_tasks.has(task)) {
-			continue;
+bool BTProbabilitySelector::_is_table_valid() const {
+	const int num_children = get_child_count();
+	if (weights_dirty || table_children.size() != num_children) {
+		return false;
+	}
+	const BTTask *const *children = table_children.ptr();
+	for (int i = 0; i < num_children; i++) {
+		const BTTask *child = get_child(i).ptr();
+		if (children[i] != (child->is_enabled() ? child : nullptr)) {
+			return false;
 		}
-		double weight = _get_weight(i);
-		if (weight == 0) {
-			continue;
+	}
+	return true;
+}
+
+void BTProbabilitySelector::_update_table() {
+	const int num_children = get_child_count();
+	weights.resize(num_children);
+	table_children.resize(num_children);
+	table.candidates.clear();
+	for (int i = 0; i < num_children; i++) {
+		const Ref<BTTask> child = get_child(i);
+		double weight = child->is_enabled() ? _get_weight(i) : 0.0;
+		weights.set(i, weight);
+		table_children.set(i, child->is_enabled() ? child.ptr() : nullptr);
+		if (weight > 0.0) {
+			table.candidates.push_back(i);
 		}
-		if (roll > weight) {
-			roll -= weight;
-			continue;
+	}
+	_build_cumulative(table, weights);
+	weights_dirty = false;
+
+	if (has_failures) {
+		// Weights changed while running: drop children that already failed from the fresh table.
+		remaining.candidates = table.candidates;
+		for (int i = 0; i < failed_children.size(); i++) {
+			_swap_out(remaining, failed_children[i]);
 		}
+		_build_cumulative(remaining, weights);
+	}
+}
+
+void BTProbabilitySelector::_remove_failed(int p_child_idx) {
+	if (!has_failures) {
+		// Copy-on-write: the shared table stays intact for the next run.
+		remaining.candidates = table.candidates;
+		has_failures = true;
+	}
+	failed_children.push_back(p_child_idx);
+	_swap_out(remaining, p_child_idx);
+	_build_cumulative(remaining, weights);
+}
 
-		selected_task = task;
-		break;
+void BTProbabilitySelector::_select_task() {
+	selected_idx = -1;
+
+	if (unlikely(weights_dirty || weights.size() != get_child_count())) {
+		_update_table();
+	}
+
+	const SelectionTable &active = has_failures ? remaining : table;
+	const int num_candidates = active.candidates.size();
+	if (num_candidates == 0) {
+		return;
+	}
+
+	// Binary search for the first prefix sum that exceeds the roll.
+	const double *cumulative = active.cumulative.ptr();
+	double roll = _randf_range(0.0, cumulative[num_candidates - 1]);
+	int lo = 0;
+	int hi = num_candidates - 1;
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (roll < cumulative[mid]) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
 	}
+	selected_idx = active.candidates[lo];
 }
 
 //***** Godot
@@ -16,11 +16,11 @@
 #include "../bt_composite.h"
 
 #ifdef LIMBOAI_MODULE
-#include "core/templates/hash_set.h"
+#include "core/templates/vector.h"
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
-#include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/vector.hpp>
 #endif // LIMBOAI_GDEXTENSION
 
 class BTProbabilitySelector : public BTComposite {
@@ -28,16 +28,33 @@ class BTProbabilitySelector : public BTComposite {
 	TASK_CATEGORY(Composites);
 
 private:
-	HashSet<Ref<BTTask>> failed_tasks;
-	Ref<BTTask> selected_task;
+	// Weights are cached in flat arrays and the prefix-sum table is rebuilt only when weights change.
+	struct SelectionTable {
+		Vector<int> candidates; // Indices of children with non-zero weight.
+		Vector<double> cumulative; // Prefix sums of candidate weights.
+	};
+
+	Vector<double> weights;
+	Vector<const BTTask *> table_children; // Enabled children at the time the table was built, nullptr for disabled ones.
+	SelectionTable table;
+	SelectionTable remaining; // Used only after a child fails: a copy of the table without failed children.
+	Vector<int> failed_children;
+	bool weights_dirty = true;
+	bool has_failures = false;
+	int selected_idx = -1;
 	bool abort_on_failure = false;
 
+	bool _is_table_valid() const;
+	void _update_table();
+	void _remove_failed(int p_child_idx);
 	void _select_task();
+	static void _swap_out(SelectionTable &r_table, int p_child_idx);
+	static void _build_cumulative(SelectionTable &r_table, const Vector<double> &p_weights);
 	_FORCE_INLINE_ double _get_weight(int p_index) const { return get_child(p_index)->get_meta(LW_NAME(_weight_), 1.0); }
-	_FORCE_INLINE_ double _get_weight(Ref<BTTask> p_task) const { return p_task->get_meta(LW_NAME(_weight_), 1.0); }
 	_FORCE_INLINE_ void _set_weight(int p_index, double p_weight) {
 		get_child(p_index)->set_meta(LW_NAME(_weight_), Variant(p_weight));
 		get_child(p_index)->emit_signal(LW_NAME(changed));
+		weights_dirty = true;
 	}
 	_FORCE_INLINE_ double _get_total_weight() const {
 		double total = 0.0;
@@ -52,9 +69,12 @@ private:
 protected:
 	static void _bind_methods();
 
+	virtual void _setup() override;
 	virtual void _enter() override;
 	virtual void _exit() override;
 	virtual Status _tick(double p_delta) override;
+	virtual Variant _get_runtime_state() const override;
+	virtual void _set_runtime_state(const Variant &p_state) override;
 
 public:
 	double get_weight(int p_index) const;
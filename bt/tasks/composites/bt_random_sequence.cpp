@@ -16,10 +16,10 @@ void BTRandomSequence::_enter() {
 	if (indicies.size() != get_child_count()) {
 		indicies.resize(get_child_count());
 		for (int i = 0; i < get_child_count(); i++) {
-			indicies[i] = i;
+			indicies.set(i, i);
 		}
 	}
-	indicies.shuffle();
+	_shuffle_indices(indicies);
 }
 
 BT::Status BTRandomSequence::_tick(double p_delta) {
@@ -33,3 +33,26 @@ BT::Status BTRandomSequence::_tick(double p_delta) {
 	}
 	return status;
 }
+
+Variant BTRandomSequence::_get_runtime_state() const {
+	PackedInt32Array order;
+	order.resize(indicies.size());
+	for (int i = 0; i < indicies.size(); i++) {
+		order.set(i, indicies[i]);
+	}
+	Array state;
+	state.push_back(last_running_idx);
+	state.push_back(order);
+	return state;
+}
+
+void BTRandomSequence::_set_runtime_state(const Variant &p_state) {
+	Array state = p_state;
+	ERR_FAIL_COND(state.size() != 2);
+	last_running_idx = state[0];
+	PackedInt32Array order = state[1];
+	indicies.resize(order.size());
+	for (int i = 0; i < order.size(); i++) {
+		indicies.set(i, order[i]);
+	}
+}
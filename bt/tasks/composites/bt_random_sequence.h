@@ -20,13 +20,15 @@ class BTRandomSequence : public BTComposite {
 
 private:
 	int last_running_idx = 0;
-	Array indicies;
+	Vector<int> indicies;
 
 protected:
 	static void _bind_methods() {}
 
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual Variant _get_runtime_state() const override;
+	virtual void _set_runtime_state(const Variant &p_state) override;
 };
 
 #endif // BT_RANDOM_SEQUENCE_H
@@ -26,3 +26,11 @@ BT::Status BTSelector::_tick(double p_delta) {
 	}
 	return status;
 }
+
+Variant BTSelector::_get_runtime_state() const {
+	return last_running_idx;
+}
+
+void BTSelector::_set_runtime_state(const Variant &p_state) {
+	last_running_idx = p_state;
+}
@@ -69,12 +69,32 @@ BT::Status BTCooldown::_tick(double p_delta) {
 	return status;
 }
 
+Variant BTCooldown::_get_runtime_state() const {
+	return timer.is_valid() ? timer->get_time_left() : 0.0;
+}
+
+void BTCooldown::_set_runtime_state(const Variant &p_state) {
+	double time_left = p_state;
+	get_blackboard()->set_var(cooldown_state_var, time_left > 0.0);
+	if (time_left > 0.0) {
+		_start_timer(time_left);
+	} else if (timer.is_valid()) {
+		// SceneTreeTimer can't be stopped, so just stop listening to it.
+		timer->disconnect(LW_NAME(timeout), callable_mp(this, &BTCooldown::_on_timeout));
+		timer.unref();
+	}
+}
+
 void BTCooldown::_chill() {
 	get_blackboard()->set_var(cooldown_state_var, true);
+	_start_timer(duration);
+}
+
+void BTCooldown::_start_timer(double p_time) {
 	if (timer.is_valid()) {
-		timer->set_time_left(duration);
+		timer->set_time_left(p_time);
 	} else {
-		timer = SCENE_TREE()->create_timer(duration, process_pause);
+		timer = SCENE_TREE()->create_timer(p_time, process_pause);
 		ERR_FAIL_COND(timer.is_null());
 		timer->connect(LW_NAME(timeout), callable_mp(this, &BTCooldown::_on_timeout), CONNECT_ONE_SHOT);
 	}
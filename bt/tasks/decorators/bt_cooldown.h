@@ -36,6 +36,7 @@ private:
 	Ref<SceneTreeTimer> timer = nullptr;
 
 	void _chill();
+	void _start_timer(double p_time);
 	void _on_timeout();
 
 protected:
@@ -44,6 +45,8 @@ protected:
 	virtual String _generate_name() override;
 	virtual void _setup() override;
 	virtual Status _tick(double p_delta) override;
+	virtual Variant _get_runtime_state() const override;
+	virtual void _set_runtime_state(const Variant &p_state) override;
 
 public:
 	void set_duration(double p_value);
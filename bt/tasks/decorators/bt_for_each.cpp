@@ -14,6 +14,60 @@
 #include "../../../blackboard/blackboard.h"
 #include "../../../util/limbo_utility.h"
 
+// Returns the size of an array-like Variant without converting packed arrays into Array.
+static int _get_array_size(const Variant &p_array) {
+	switch (p_array.get_type()) {
+		case Variant::ARRAY: {
+			Array arr = p_array;
+			return arr.size();
+		}
+		case Variant::PACKED_BYTE_ARRAY: {
+			PackedByteArray arr = p_array;
+			return arr.size();
+		}
+		case Variant::PACKED_INT32_ARRAY: {
+			PackedInt32Array arr = p_array;
+			return arr.size();
+		}
+		case Variant::PACKED_INT64_ARRAY: {
+			PackedInt64Array arr = p_array;
+			return arr.size();
+		}
+		case Variant::PACKED_FLOAT32_ARRAY: {
+			PackedFloat32Array arr = p_array;
+			return arr.size();
+		}
+		case Variant::PACKED_FLOAT64_ARRAY: {
+			PackedFloat64Array arr = p_array;
+			return arr.size();
+		}
+		case Variant::PACKED_STRING_ARRAY: {
+			PackedStringArray arr = p_array;
+			return arr.size();
+		}
+		case Variant::PACKED_VECTOR2_ARRAY: {
+			PackedVector2Array arr = p_array;
+			return arr.size();
+		}
+		case Variant::PACKED_VECTOR3_ARRAY: {
+			PackedVector3Array arr = p_array;
+			return arr.size();
+		}
+		case Variant::PACKED_COLOR_ARRAY: {
+			PackedColorArray arr = p_array;
+			return arr.size();
+		}
+		default: {
+			return 0;
+		}
+	}
+}
+
+static _FORCE_INLINE_ Variant _get_array_element(const Variant &p_array, int p_idx, bool &r_oob) {
+	bool valid;
+	return p_array.get_indexed(p_idx, valid, r_oob);
+}
+
 //**** Setters / Getters
 
 void BTForEach::set_array_var(const StringName &p_value) {
@@ -26,6 +80,11 @@ void BTForEach::set_save_var(const StringName &p_value) {
 	emit_changed();
 }
 
+void BTForEach::set_cache_array(bool p_value) {
+	cache_array = p_value;
+	emit_changed();
+}
+
 //**** Task Implementation
 
 String BTForEach::_generate_name() {
@@ -36,6 +95,17 @@ String BTForEach::_generate_name() {
 
 void BTForEach::_enter() {
 	current_idx = 0;
+	if (cache_array && array_var != StringName()) {
+		// Arrays are shared and packed arrays are copy-on-write, so this doesn't copy any elements.
+		cached_array = get_blackboard()->get_var(array_var, Variant());
+		cached_size = _get_array_size(cached_array);
+		save_pending = true;
+	}
+}
+
+void BTForEach::_exit() {
+	cached_array = Variant();
+	cached_size = 0;
 }
 
 BT::Status BTForEach::_tick(double p_delta) {
@@ -43,25 +113,82 @@ BT::Status BTForEach::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(save_var == StringName(), FAILURE, "BTForEach: Save variable is not set.");
 	ERR_FAIL_COND_V_MSG(array_var == StringName(), FAILURE, "BTForEach: Array variable is not set.");
 
-	Array arr = get_blackboard()->get_var(array_var, Variant());
-	if (current_idx >= arr.size()) {
+	if (cache_array) {
+		return _tick_cached(p_delta);
+	}
+
+	Variant arr = get_blackboard()->get_var(array_var, Variant());
+	int size = _get_array_size(arr);
+	if (current_idx >= size) {
+		if (current_idx != 0) {
+			WARN_PRINT("BTForEach: Array size changed during iteration.");
+		}
+		return SUCCESS;
+	}
+	bool oob = false;
+	get_blackboard()->set_var(save_var, _get_array_element(arr, current_idx, oob));
+
+	Status status = get_child(0)->execute(p_delta);
+	if (status == RUNNING) {
+		return RUNNING;
+	} else if (status == FAILURE) {
+		return FAILURE;
+	} else if (current_idx == (size - 1)) {
+		return SUCCESS;
+	} else {
+		current_idx += 1;
+		return RUNNING;
+	}
+}
+
+Variant BTForEach::_get_runtime_state() const {
+	Array state;
+	state.push_back(current_idx);
+	state.push_back(save_pending);
+	state.push_back(cached_array);
+	return state;
+}
+
+void BTForEach::_set_runtime_state(const Variant &p_state) {
+	Array state = p_state;
+	ERR_FAIL_COND(state.size() != 3);
+	current_idx = state[0];
+	save_pending = state[1];
+	cached_array = state[2];
+	cached_size = _get_array_size(cached_array);
+}
+
+BT::Status BTForEach::_tick_cached(double p_delta) {
+	if (current_idx >= cached_size) {
 		if (current_idx != 0) {
 			WARN_PRINT("BTForEach: Array size changed during iteration.");
 		}
 		return SUCCESS;
 	}
-	Variant elem = arr[current_idx];
-	get_blackboard()->set_var(save_var, elem);
+
+	if (save_pending) {
+		// Only write the element when the iteration advances.
+		bool oob = false;
+		Variant elem = _get_array_element(cached_array, current_idx, oob);
+		if (unlikely(oob)) {
+			// Array is shared with the blackboard and could shrink during iteration.
+			WARN_PRINT("BTForEach: Array size changed during iteration.");
+			return SUCCESS;
+		}
+		get_blackboard()->set_var(save_var, elem);
+		save_pending = false;
+	}
 
 	Status status = get_child(0)->execute(p_delta);
 	if (status == RUNNING) {
 		return RUNNING;
 	} else if (status == FAILURE) {
 		return FAILURE;
-	} else if (current_idx == (arr.size() - 1)) {
+	} else if (current_idx == (cached_size - 1)) {
 		return SUCCESS;
 	} else {
 		current_idx += 1;
+		save_pending = true;
 		return RUNNING;
 	}
 }
@@ -73,7 +200,10 @@ void BTForEach::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_array_var"), &BTForEach::get_array_var);
 	ClassDB::bind_method(D_METHOD("set_save_var", "variable"), &BTForEach::set_save_var);
 	ClassDB::bind_method(D_METHOD("get_save_var"), &BTForEach::get_save_var);
+	ClassDB::bind_method(D_METHOD("set_cache_array", "enable"), &BTForEach::set_cache_array);
+	ClassDB::bind_method(D_METHOD("get_cache_array"), &BTForEach::get_cache_array);
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "array_var"), "set_array_var", "get_array_var");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "save_var"), "set_save_var", "get_save_var");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "cache_array"), "set_cache_array", "get_cache_array");
 }
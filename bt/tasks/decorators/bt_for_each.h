@@ -21,15 +21,24 @@ class BTForEach : public BTDecorator {
 private:
 	StringName array_var;
 	StringName save_var;
+	bool cache_array = false;
 
 	int current_idx;
+	Variant cached_array;
+	int cached_size = 0;
+	bool save_pending = false;
+
+	Status _tick_cached(double p_delta);
 
 protected:
 	static void _bind_methods();
 
 	virtual String _generate_name() override;
 	virtual void _enter() override;
+	virtual void _exit() override;
 	virtual Status _tick(double p_delta) override;
+	virtual Variant _get_runtime_state() const override;
+	virtual void _set_runtime_state(const Variant &p_state) override;
 
 public:
 	void set_array_var(const StringName &p_value);
@@ -37,6 +46,9 @@ public:
 
 	void set_save_var(const StringName &p_value);
 	StringName get_save_var() const { return save_var; }
+
+	void set_cache_array(bool p_value);
+	bool get_cache_array() const { return cache_array; }
 };
 
 #endif // BT_FOR_EACH_H
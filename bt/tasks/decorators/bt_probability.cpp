@@ -11,8 +11,6 @@
 
 #include "bt_probability.h"
 
-#include "../../../compat/math.h"
-
 void BTProbability::set_run_chance(float p_value) {
 	run_chance = p_value;
 	emit_changed();
@@ -24,7 +22,7 @@ String BTProbability::_generate_name() {
 
 BT::Status BTProbability::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(get_child_count() == 0, FAILURE, "BT decorator has no child.");
-	if (get_child(0)->get_status() == RUNNING || RANDF() <= run_chance) {
+	if (get_child(0)->get_status() == RUNNING || _randf() <= run_chance) {
 		return get_child(0)->execute(p_delta);
 	}
 	return FAILURE;
@@ -39,6 +39,14 @@ BT::Status BTRepeat::_tick(double p_delta) {
 	}
 }
 
+Variant BTRepeat::_get_runtime_state() const {
+	return cur_iteration;
+}
+
+void BTRepeat::_set_runtime_state(const Variant &p_state) {
+	cur_iteration = p_state;
+}
+
 void BTRepeat::set_forever(bool p_forever) {
 	forever = p_forever;
 	notify_property_list_changed();
@@ -32,6 +32,8 @@ protected:
 	virtual String _generate_name() override;
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual Variant _get_runtime_state() const override;
+	virtual void _set_runtime_state(const Variant &p_state) override;
 
 public:
 	void set_forever(bool p_forever);
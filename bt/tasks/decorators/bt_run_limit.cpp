@@ -39,6 +39,14 @@ BT::Status BTRunLimit::_tick(double p_delta) {
 	return child_status;
 }
 
+Variant BTRunLimit::_get_runtime_state() const {
+	return num_runs;
+}
+
+void BTRunLimit::_set_runtime_state(const Variant &p_state) {
+	num_runs = p_state;
+}
+
 void BTRunLimit::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_run_limit", "max_runs"), &BTRunLimit::set_run_limit);
 	ClassDB::bind_method(D_METHOD("get_run_limit"), &BTRunLimit::get_run_limit);
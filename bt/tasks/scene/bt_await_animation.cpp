@@ -42,6 +42,11 @@ void BTAwaitAnimation::set_max_time(double p_max_time) {
 	emit_changed();
 }
 
+void BTAwaitAnimation::set_use_signals(bool p_use_signals) {
+	use_signals = p_use_signals;
+	emit_changed();
+}
+
 //**** Task Implementation
 
 PackedStringArray BTAwaitAnimation::get_configuration_warnings() {
@@ -77,14 +82,45 @@ void BTAwaitAnimation::_setup() {
 	ERR_FAIL_COND_MSG(animation_player == nullptr, "BTAwaitAnimation: Failed to get AnimationPlayer.");
 	ERR_FAIL_COND_MSG(animation_name == StringName(), "BTAwaitAnimation: Animation Name is not set.");
 	ERR_FAIL_COND_MSG(!animation_player->has_animation(animation_name), vformat("BTAwaitAnimation: Animation not found: %s", animation_name));
+	if (use_signals) {
+		_connect_signals();
+	}
 	setup_failed = false;
 }
 
+void BTAwaitAnimation::_connect_signals() {
+	if (!animation_player->is_connected(LW_NAME(animation_finished), callable_mp(this, &BTAwaitAnimation::_on_animation_finished))) {
+		animation_player->connect(LW_NAME(animation_finished), callable_mp(this, &BTAwaitAnimation::_on_animation_finished));
+		animation_player->connect(LW_NAME(animation_changed), callable_mp(this, &BTAwaitAnimation::_on_animation_changed));
+		animation_player->connect(LW_NAME(current_animation_changed), callable_mp(this, &BTAwaitAnimation::_on_current_animation_changed));
+	}
+}
+
+void BTAwaitAnimation::_on_animation_finished(const StringName &p_animation) {
+	if (p_animation == animation_name) {
+		animation_playing = false;
+	}
+}
+
+void BTAwaitAnimation::_on_animation_changed(const StringName &p_old_animation, const StringName &p_new_animation) {
+	animation_playing = (p_new_animation == animation_name);
+}
+
+void BTAwaitAnimation::_on_current_animation_changed(const String &p_animation) {
+	animation_playing = (p_animation == String(animation_name));
+}
+
+void BTAwaitAnimation::_enter() {
+	if (use_signals && !setup_failed) {
+		// Query the player once - after that, the state is tracked with signals.
+		animation_playing = animation_player->is_playing() && animation_player->get_assigned_animation() == animation_name;
+	}
+}
+
 BT::Status BTAwaitAnimation::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(setup_failed == true, FAILURE, "BTAwaitAnimation: _setup() failed - returning FAILURE.");
 
-	// ! Doing this check instead of using signal due to a bug in Godot: https://github.com/godotengine/godot/issues/76127
-	if (animation_player->is_playing() && animation_player->get_assigned_animation() == animation_name) {
+	if (_is_animation_playing()) {
 		if (get_elapsed_time() < max_time) {
 			return RUNNING;
 		} else if (max_time > 0.0) {
@@ -103,8 +139,11 @@ void BTAwaitAnimation::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_animation_name"), &BTAwaitAnimation::get_animation_name);
 	ClassDB::bind_method(D_METHOD("set_max_time", "time_sec"), &BTAwaitAnimation::set_max_time);
 	ClassDB::bind_method(D_METHOD("get_max_time"), &BTAwaitAnimation::get_max_time);
+	ClassDB::bind_method(D_METHOD("set_use_signals", "enable"), &BTAwaitAnimation::set_use_signals);
+	ClassDB::bind_method(D_METHOD("get_use_signals"), &BTAwaitAnimation::get_use_signals);
 
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "animation_player", PROPERTY_HINT_RESOURCE_TYPE, "BBNode"), "set_animation_player", "get_animation_player");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "animation_name"), "set_animation_name", "get_animation_name");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_time", PROPERTY_HINT_RANGE, "0.0,100.0"), "set_max_time", "get_max_time");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_signals"), "set_use_signals", "get_use_signals");
 }
@@ -57,6 +57,11 @@ void BTPlayAnimation::set_from_end(bool p_from_end) {
 	emit_changed();
 }
 
+void BTPlayAnimation::set_use_signals(bool p_use_signals) {
+	use_signals = p_use_signals;
+	emit_changed();
+}
+
 //**** Task Implementation
 
 PackedStringArray BTPlayAnimation::get_configuration_warnings() {
@@ -94,20 +99,48 @@ void BTPlayAnimation::_setup() {
 	if (animation_name == StringName() && await_completion > 0.0) {
 		WARN_PRINT("BTPlayAnimation: Animation Name is required in order to wait for the animation to finish.");
 	}
+	if (use_signals) {
+		_connect_signals();
+	}
 	setup_failed = false;
 }
 
+void BTPlayAnimation::_connect_signals() {
+	if (!animation_player->is_connected(LW_NAME(animation_finished), callable_mp(this, &BTPlayAnimation::_on_animation_finished))) {
+		animation_player->connect(LW_NAME(animation_finished), callable_mp(this, &BTPlayAnimation::_on_animation_finished));
+		animation_player->connect(LW_NAME(animation_changed), callable_mp(this, &BTPlayAnimation::_on_animation_changed));
+		animation_player->connect(LW_NAME(current_animation_changed), callable_mp(this, &BTPlayAnimation::_on_current_animation_changed));
+	}
+}
+
+void BTPlayAnimation::_on_animation_finished(const StringName &p_animation) {
+	if (p_animation == animation_name) {
+		animation_playing = false;
+	}
+}
+
+void BTPlayAnimation::_on_animation_changed(const StringName &p_old_animation, const StringName &p_new_animation) {
+	animation_playing = (p_new_animation == animation_name);
+}
+
+void BTPlayAnimation::_on_current_animation_changed(const String &p_animation) {
+	animation_playing = (p_animation == String(animation_name));
+}
+
 void BTPlayAnimation::_enter() {
 	if (!setup_failed) {
 		animation_player->play(animation_name, blend, speed, from_end);
+		if (use_signals) {
+			// Query the player once - after that, the state is tracked with signals.
+			animation_playing = animation_player->is_playing() && animation_player->get_assigned_animation() == animation_name;
+		}
 	}
 }
 
 BT::Status BTPlayAnimation::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(setup_failed == true, FAILURE, "BTPlayAnimation: _setup() failed - returning FAILURE.");
 
-	// ! Doing this check instead of using signal due to a bug in Godot: https://github.com/godotengine/godot/issues/76127
-	if (animation_player->is_playing() && animation_player->get_assigned_animation() == animation_name) {
+	if (_is_animation_playing()) {
 		if (get_elapsed_time() < await_completion) {
 			return RUNNING;
 		} else if (await_completion > 0.0) {
@@ -132,6 +165,8 @@ void BTPlayAnimation::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_speed"), &BTPlayAnimation::get_speed);
 	ClassDB::bind_method(D_METHOD("set_from_end", "from_end"), &BTPlayAnimation::set_from_end);
 	ClassDB::bind_method(D_METHOD("get_from_end"), &BTPlayAnimation::get_from_end);
+	ClassDB::bind_method(D_METHOD("set_use_signals", "enable"), &BTPlayAnimation::set_use_signals);
+	ClassDB::bind_method(D_METHOD("get_use_signals"), &BTPlayAnimation::get_use_signals);
 
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "await_completion", PROPERTY_HINT_RANGE, "0.0,100.0"), "set_await_completion", "get_await_completion");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "animation_player", PROPERTY_HINT_RESOURCE_TYPE, "BBNode"), "set_animation_player", "get_animation_player");
@@ -139,4 +174,5 @@ void BTPlayAnimation::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "blend"), "set_blend", "get_blend");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "speed"), "set_speed", "get_speed");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "from_end"), "set_from_end", "get_from_end");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_signals"), "set_use_signals", "get_use_signals");
 }
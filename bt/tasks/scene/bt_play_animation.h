@@ -36,8 +36,25 @@ private:
 	double speed = 1.0;
 	bool from_end = false;
 
+	bool use_signals = false;
+
 	AnimationPlayer *animation_player = nullptr;
 	bool setup_failed = false;
+	bool animation_playing = false; // Updated by AnimationPlayer signals if use_signals is enabled.
+
+	_FORCE_INLINE_ bool _is_animation_playing() const {
+		if (use_signals) {
+			// AnimationPlayer::stop() emits none of the tracked signals, so also check the cheap playing flag.
+			return animation_playing && animation_player->is_playing();
+		}
+		// ! Doing this check instead of using signal due to a bug in Godot: https://github.com/godotengine/godot/issues/76127
+		return animation_player->is_playing() && animation_player->get_assigned_animation() == animation_name;
+	}
+
+	void _connect_signals();
+	void _on_animation_finished(const StringName &p_animation);
+	void _on_animation_changed(const StringName &p_old_animation, const StringName &p_new_animation);
+	void _on_current_animation_changed(const String &p_animation);
 
 protected:
 	static void _bind_methods();
@@ -66,6 +83,9 @@ public:
 	void set_from_end(bool p_from_end);
 	bool get_from_end() const { return from_end; }
 
+	void set_use_signals(bool p_use_signals);
+	bool get_use_signals() const { return use_signals; }
+
 	virtual PackedStringArray get_configuration_warnings() override;
 };
 
@@ -93,31 +93,44 @@ BT::Status BTCallMethod::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(obj == nullptr, FAILURE, "BTCallMethod: Failed to get object: " + node_param->to_string());
 
 	Variant result;
-	Array call_args;
 
 #ifdef LIMBOAI_MODULE
 	const Variant delta = include_delta ? Variant(p_delta) : Variant();
 	const Variant **argptrs = nullptr;
+	// Argument values live on the stack to keep the tick free of heap allocations.
+	const int num_args = args.size();
+	Variant *arg_values = nullptr;
 
-	int argument_count = include_delta ? args.size() + 1 : args.size();
+	int argument_count = include_delta ? num_args + 1 : num_args;
 	if (argument_count > 0) {
 		argptrs = (const Variant **)alloca(sizeof(Variant *) * argument_count);
 		if (include_delta) {
 			argptrs[0] = &delta;
 		}
-		for (int i = 0; i < args.size(); i++) {
+		if (num_args > 0) {
+			arg_values = (Variant *)alloca(sizeof(Variant) * num_args);
+		}
+		for (int i = 0; i < num_args; i++) {
 			Ref<BBVariant> param = args[i];
-			call_args.push_back(param->get_value(get_scene_root(), get_blackboard()));
-			argptrs[i + int(include_delta)] = &call_args[i];
+			memnew_placement(&arg_values[i], Variant(param->get_value(get_scene_root(), get_blackboard())));
+			argptrs[i + int(include_delta)] = &arg_values[i];
 		}
 	}
 
 	Callable::CallError ce;
 	result = obj->callp(method, argptrs, argument_count, ce);
 	if (ce.error != Callable::CallError::CALL_OK) {
-		ERR_FAIL_V_MSG(FAILURE, "BTCallMethod: Error calling method: " + Variant::get_call_error_text(obj, method, argptrs, argument_count, ce) + ".");
+		String error_text = Variant::get_call_error_text(obj, method, argptrs, argument_count, ce);
+		for (int i = 0; i < num_args; i++) {
+			arg_values[i].~Variant();
+		}
+		ERR_FAIL_V_MSG(FAILURE, "BTCallMethod: Error calling method: " + error_text + ".");
+	}
+	for (int i = 0; i < num_args; i++) {
+		arg_values[i].~Variant();
 	}
 #elif LIMBOAI_GDEXTENSION
+	Array call_args;
 	if (include_delta) {
 		call_args.push_back(Variant(p_delta));
 	}
@@ -20,7 +20,7 @@ String BTRandomWait::_generate_name() {
 }
 
 void BTRandomWait::_enter() {
-	duration = RAND_RANGE(min_duration, max_duration);
+	duration = _randf_range(min_duration, max_duration);
 }
 
 BT::Status BTRandomWait::_tick(double p_delta) {
@@ -31,6 +31,14 @@ BT::Status BTRandomWait::_tick(double p_delta) {
 	}
 }
 
+Variant BTRandomWait::_get_runtime_state() const {
+	return duration;
+}
+
+void BTRandomWait::_set_runtime_state(const Variant &p_state) {
+	duration = p_state;
+}
+
 void BTRandomWait::set_min_duration(double p_max_duration) {
 	min_duration = p_max_duration;
 	if (max_duration < min_duration) {
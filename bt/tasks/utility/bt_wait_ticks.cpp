@@ -28,6 +28,14 @@ BT::Status BTWaitTicks::_tick(double p_delta) {
 	}
 }
 
+Variant BTWaitTicks::_get_runtime_state() const {
+	return num_passed;
+}
+
+void BTWaitTicks::_set_runtime_state(const Variant &p_state) {
+	num_passed = p_state;
+}
+
 void BTWaitTicks::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_num_ticks", "num_ticks"), &BTWaitTicks::set_num_ticks);
 	ClassDB::bind_method(D_METHOD("get_num_ticks"), &BTWaitTicks::get_num_ticks);
@@ -15,12 +15,14 @@
 #include "core/math/math_funcs.h"
 #define RAND_RANGE(m_from, m_to) (Math::random(m_from, m_to))
 #define RANDF() (Math::randf())
+#define RANDI_RANGE(m_from, m_to) (Math::random((int32_t)(m_from), (int32_t)(m_to)))
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/variant/utility_functions.hpp>
 #define RAND_RANGE(m_from, m_to) (godot::UtilityFunctions::randf_range(m_from, m_to))
 #define RANDF() (godot::UtilityFunctions::randf())
+#define RANDI_RANGE(m_from, m_to) (godot::UtilityFunctions::randi_range(m_from, m_to))
 #endif // LIMBOAI_GDEXTENSION
 
 #endif // COMPAT_MATH_H
@@ -0,0 +1,27 @@
+/**
+ * mutex.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+#ifndef COMPAT_MUTEX_H
+#define COMPAT_MUTEX_H
+
+#ifdef LIMBOAI_MODULE
+#include "core/os/mutex.h"
+#define LIMBO_MUTEX Mutex
+#define LIMBO_MUTEX_LOCK(m_mutex) MutexLock _limbo_mutex_lock_(m_mutex)
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+// Note: godot::Mutex is a RefCounted object in godot-cpp, so we use the standard mutex directly.
+#include <mutex>
+#define LIMBO_MUTEX std::mutex
+#define LIMBO_MUTEX_LOCK(m_mutex) std::lock_guard<std::mutex> _limbo_mutex_lock_(m_mutex)
+#endif // LIMBOAI_GDEXTENSION
+
+#endif // COMPAT_MUTEX_H
@@ -10,12 +10,18 @@
  */
 #include "variant.h"
 
+#include "object.h"
+
 #ifdef LIMBOAI_MODULE
+#include "core/io/marshalls.h"
 #include "core/object/ref_counted.h"
+#include "core/variant/variant_utility.h"
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/encoded_object_as_id.hpp>
 #include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
 #endif // LIMBOAI_GDEXTENSION
 
 void VARIANT_DELETE_IF_OBJECT(const Variant &p_variant) {
@@ -148,3 +154,30 @@ Variant VARIANT_DEFAULT(Variant::Type p_type) {
 		}
 	}
 }
+
+PackedByteArray VARIANT_TO_BYTES(const Variant &p_variant) {
+#ifdef LIMBOAI_MODULE
+	return VariantUtilityFunctions::var_to_bytes(p_variant);
+#elif LIMBOAI_GDEXTENSION
+	return UtilityFunctions::var_to_bytes(p_variant);
+#endif
+}
+
+Variant VARIANT_FROM_BYTES(const PackedByteArray &p_bytes) {
+#ifdef LIMBOAI_MODULE
+	return VariantUtilityFunctions::bytes_to_var(p_bytes);
+#elif LIMBOAI_GDEXTENSION
+	return UtilityFunctions::bytes_to_var(p_bytes);
+#endif
+}
+
+Variant VARIANT_RESOLVE_OBJECT_ID(const Variant &p_variant) {
+	if (p_variant.get_type() != Variant::OBJECT) {
+		return p_variant;
+	}
+	Ref<EncodedObjectAsID> encoded = p_variant;
+	if (encoded.is_null()) {
+		return p_variant;
+	}
+	return OBJECT_DB_GET_INSTANCE(encoded->get_object_id());
+}
@@ -37,4 +37,10 @@ void VARIANT_DELETE_IF_OBJECT(const Variant &p_variant);
 
 Variant VARIANT_DEFAULT(Variant::Type p_type);
 
+// Binary encoding without full objects: objects are encoded by instance ID.
+PackedByteArray VARIANT_TO_BYTES(const Variant &p_variant);
+Variant VARIANT_FROM_BYTES(const PackedByteArray &p_bytes);
+// Resolves EncodedObjectAsID produced by VARIANT_FROM_BYTES() into a live object (or null).
+Variant VARIANT_RESOLVE_OBJECT_ID(const Variant &p_variant);
+
 #endif // COMPAT_VARIANT_H
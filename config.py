@@ -5,6 +5,18 @@ def can_build(env, platform):
     return True
 
 
+def get_opts(platform):
+    from SCons.Variables import BoolVariable
+
+    return [
+        BoolVariable(
+            "limboai_track_allocations",
+            "Count heap allocations in LimboAI unit tests (requires tests=yes, Linux only)",
+            False,
+        ),
+    ]
+
+
 def configure(env):
     pass
 
@@ -58,6 +70,7 @@ def get_doc_classes():
         "BBVector4",
         "BBVector4i",
         "BehaviorTree",
+        "BehaviorTreeGenerator",
         "BehaviorTreeData",
         "BehaviorTreeView",
         "Blackboard",
@@ -110,7 +123,10 @@ def get_doc_classes():
         "BTTimeLimit",
         "BTWait",
         "BTWaitTicks",
+        "LimboGuard",
         "LimboHSM",
+        "LimboMetrics",
+        "LimboProfiler",
         "LimboState",
         "LimboUtility",
     ]
@@ -0,0 +1,34 @@
+#*
+#* bench_agent.gd
+#* =============================================================================
+#* Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+#*
+#* Use of this source code is governed by an MIT-style
+#* license that can be found in the LICENSE file or at
+#* https://opensource.org/licenses/MIT.
+#* =============================================================================
+#*
+extends Node2D
+## Minimal agent used by the crowd benchmark. It has no visuals or physics,
+## so that measurements are dominated by behavior tree execution.
+
+const ARENA_SIZE := 1000.0
+
+var velocity: Vector2 = Vector2.RIGHT.rotated(randf() * TAU) * 50.0
+var thoughts: int = 0
+
+## Used by the manual driver, which updates instances directly.
+var bt_instance: BTInstance
+
+
+func think() -> void:
+	thoughts += 1
+	velocity = velocity.rotated(randf_range(-0.5, 0.5))
+
+
+func wander(delta: float) -> void:
+	position += velocity * delta
+	if position.x < 0.0 or position.x > ARENA_SIZE:
+		velocity.x = -velocity.x
+	if position.y < 0.0 or position.y > ARENA_SIZE:
+		velocity.y = -velocity.y
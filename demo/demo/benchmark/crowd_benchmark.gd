@@ -0,0 +1,239 @@
+#*
+#* crowd_benchmark.gd
+#* =============================================================================
+#* Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+#*
+#* Use of this source code is governed by an MIT-style
+#* license that can be found in the LICENSE file or at
+#* https://opensource.org/licenses/MIT.
+#* =============================================================================
+#*
+extends Node
+## Crowd-scale benchmark: spawns N agents with a representative behavior tree
+## and compares BTPlayer, BTState and manual BTInstance.update() drivers.
+##
+## Run headless from the demo project directory:
+##   godot --headless res://demo/benchmark/crowd_benchmark.tscn -- --agents=1000,10000,50000
+## Options (all optional):
+##   --agents=1000,10000      Agent counts to test.
+##   --drivers=player,state,manual
+##   --frames=300             Number of measured frames per case.
+##   --warmup=30              Frames to skip before measuring.
+##   --seed=1                 Random seed, for reproducible runs.
+##   --output=user://crowd_benchmark.json
+## Results are printed and saved as JSON.
+
+const BenchAgent := preload("res://demo/benchmark/bench_agent.gd")
+
+var agent_counts: Array[int] = [1000, 10000, 50000]
+var drivers: PackedStringArray = ["player", "state", "manual"]
+var num_frames: int = 300
+var num_warmup_frames: int = 30
+var random_seed: int = 1
+var output_path: String = "user://crowd_benchmark.json"
+
+var _container: Node2D
+var _manual_agents: Array[BenchAgent] = []
+
+
+func _ready() -> void:
+	_parse_args()
+	_container = Node2D.new()
+	_container.name = &"Agents"
+	add_child(_container)
+	set_process(false)
+
+	var results: Array[Dictionary] = []
+	for driver in drivers:
+		for num_agents in agent_counts:
+			print("Running: driver=%s agents=%d" % [driver, num_agents])
+			var result: Dictionary = await _run_case(driver, num_agents)
+			print("  ", JSON.stringify(result))
+			results.append(result)
+
+	var report := {
+		"engine_version": Engine.get_version_info().string,
+		"debug_build": OS.is_debug_build(),
+		"frames": num_frames,
+		"seed": random_seed,
+		"results": results,
+	}
+	var file := FileAccess.open(output_path, FileAccess.WRITE)
+	if file:
+		file.store_string(JSON.stringify(report, "\t"))
+		print("Results saved to ", ProjectSettings.globalize_path(output_path))
+	else:
+		push_error("Failed to write results to " + output_path)
+	get_tree().quit()
+
+
+func _process(delta: float) -> void:
+	for agent in _manual_agents:
+		agent.bt_instance.update(delta)
+
+
+func _parse_args() -> void:
+	for arg in OS.get_cmdline_user_args():
+		var parts := arg.trim_prefix("--").split("=", true, 1)
+		if parts.size() != 2:
+			continue
+		match parts[0]:
+			"agents":
+				agent_counts.clear()
+				for n in parts[1].split(","):
+					agent_counts.append(n.to_int())
+			"drivers":
+				drivers = parts[1].split(",")
+			"frames":
+				num_frames = parts[1].to_int()
+			"warmup":
+				num_warmup_frames = parts[1].to_int()
+			"seed":
+				random_seed = parts[1].to_int()
+			"output":
+				output_path = parts[1]
+
+
+func _run_case(driver: String, num_agents: int) -> Dictionary:
+	seed(random_seed)
+	var bt := _create_behavior_tree()
+
+	# Spawn.
+	var mem_before := OS.get_static_memory_usage()
+	var spawn_start := Time.get_ticks_usec()
+	for i in num_agents:
+		_spawn_agent(driver, bt)
+	var spawn_usec := Time.get_ticks_usec() - spawn_start
+	var mem_per_agent := float(OS.get_static_memory_usage() - mem_before) / num_agents
+	set_process(driver == "manual")
+
+	# Measure frames.
+	for i in num_warmup_frames:
+		await get_tree().process_frame
+	var ticks_before := LimboMetrics.get_tick_count()
+	var frame_times: Array[float] = []
+	var last := Time.get_ticks_usec()
+	for i in num_frames:
+		await get_tree().process_frame
+		var now := Time.get_ticks_usec()
+		frame_times.append((now - last) * 0.001)
+		last = now
+	var ticks := LimboMetrics.get_tick_count() - ticks_before
+
+	# Despawn.
+	set_process(false)
+	_manual_agents.clear()
+	var despawn_start := Time.get_ticks_usec()
+	for agent in _container.get_children():
+		agent.free()
+	var despawn_usec := Time.get_ticks_usec() - despawn_start
+
+	frame_times.sort()
+	return {
+		"driver": driver,
+		"agents": num_agents,
+		"frame_ms_mean": _mean(frame_times),
+		"frame_ms_p50": frame_times[frame_times.size() / 2],
+		"frame_ms_p95": frame_times[int(frame_times.size() * 0.95)],
+		"frame_ms_max": frame_times[-1],
+		"ticks_per_frame": float(ticks) / num_frames,
+		"memory_per_agent_bytes": mem_per_agent,
+		"spawn_per_sec": num_agents / maxf(spawn_usec * 0.000001, 0.000001),
+		"despawn_per_sec": num_agents / maxf(despawn_usec * 0.000001, 0.000001),
+	}
+
+
+func _spawn_agent(driver: String, bt: BehaviorTree) -> void:
+	var agent: BenchAgent = BenchAgent.new()
+	agent.position = Vector2(randf(), randf()) * BenchAgent.ARENA_SIZE
+	match driver:
+		"player":
+			var player := BTPlayer.new()
+			player.behavior_tree = bt
+			player.update_mode = BTPlayer.IDLE
+			agent.add_child(player)
+			player.owner = agent
+			_container.add_child(agent)
+		"state":
+			var hsm := LimboHSM.new()
+			hsm.update_mode = LimboHSM.IDLE
+			var state := BTState.new()
+			state.behavior_tree = bt
+			hsm.add_child(state)
+			agent.add_child(hsm)
+			hsm.owner = agent
+			state.owner = agent
+			_container.add_child(agent)
+			hsm.initialize(agent)
+			hsm.set_active(true)
+		"manual":
+			_container.add_child(agent)
+			agent.bt_instance = bt.instantiate(agent, Blackboard.new(), agent, agent)
+			_manual_agents.append(agent)
+		_:
+			push_error("Unknown driver: " + driver)
+			agent.free()
+
+
+## Builds a tree that is representative of typical agent logic:
+## selectors, cooldowns, method calls, expressions and subtrees.
+func _create_behavior_tree() -> BehaviorTree:
+	var agent_param := BBNode.new()
+	agent_param.saved_value = NodePath(".")
+
+	# Subtree: wander around and remember the current mode.
+	var wander := BTCallMethod.new()
+	wander.node = agent_param
+	wander.method = &"wander"
+	wander.args_include_delta = true
+	var mode := BBVariant.new()
+	mode.type = TYPE_INT
+	mode.saved_value = 1
+	var set_mode := BTSetVar.new()
+	set_mode.variable = &"mode"
+	set_mode.value = mode
+	var wander_seq := BTSequence.new()
+	wander_seq.add_child(wander)
+	wander_seq.add_child(set_mode)
+	var wander_bt := BehaviorTree.new()
+	wander_bt.root_task = wander_seq
+
+	# Main branch: when on the right half of the arena, think once in a while.
+	var is_far := BTEvaluateExpression.new()
+	is_far.node = agent_param
+	is_far.expression_string = "position.x > 500.0"
+	is_far.result_var = &"far"
+	var expected := BBVariant.new()
+	expected.type = TYPE_BOOL
+	expected.saved_value = true
+	var check_far := BTCheckVar.new()
+	check_far.variable = &"far"
+	check_far.value = expected
+	var think := BTCallMethod.new()
+	think.node = agent_param
+	think.method = &"think"
+	var cooldown := BTCooldown.new()
+	cooldown.duration = 0.5
+	cooldown.add_child(think)
+	var react_seq := BTSequence.new()
+	react_seq.add_child(is_far)
+	react_seq.add_child(check_far)
+	react_seq.add_child(cooldown)
+
+	var subtree := BTSubtree.new()
+	subtree.subtree = wander_bt
+
+	var root := BTSelector.new()
+	root.add_child(react_seq)
+	root.add_child(subtree)
+
+	var bt := BehaviorTree.new()
+	bt.root_task = root
+	return bt
+
+
+func _mean(values: Array[float]) -> float:
+	var total := 0.0
+	for v in values:
+		total += v
+	return total / maxi(values.size(), 1)
@@ -11,47 +11,17 @@
 
 #include "behavior_tree_data.h"
 
-#ifdef LIMBOAI_MODULE
-#include "core/templates/list.h"
-#endif
+#include "../../bt/bt_trace_recorder.h"
+#include "../../compat/variant.h"
 
 //**** BehaviorTreeData
 
-Array BehaviorTreeData::serialize(const Ref<BTInstance> &p_instance) {
-	Array arr;
-	arr.push_back(uint64_t(p_instance->get_instance_id()));
-	arr.push_back(p_instance->get_owner_node() ? p_instance->get_owner_node()->get_path() : NodePath());
-	arr.push_back(p_instance->get_source_bt_path());
-
-	// Flatten tree into list depth first
-	List<Ref<BTTask>> stack;
-	stack.push_back(p_instance->get_root_task());
-	while (stack.size()) {
-		Ref<BTTask> task = stack.front()->get();
-		stack.pop_front();
-
-		int num_children = task->get_child_count();
-		for (int i = 0; i < num_children; i++) {
-			stack.push_front(task->get_child(num_children - 1 - i));
-		}
-
-		String script_path;
-		if (task->get_script()) {
-			Ref<Resource> s = task->get_script();
-			script_path = s->get_path();
-		}
-
-		arr.push_back(task->get_instance_id());
-		arr.push_back(task->get_task_name());
-		arr.push_back(!task->get_custom_name().is_empty());
-		arr.push_back(num_children);
-		arr.push_back(task->get_status());
-		arr.push_back(task->get_elapsed_time());
-		arr.push_back(task->get_class());
-		arr.push_back(script_path);
-	}
+Vector<Ref<BTTask>> BehaviorTreeData::get_tasks_depth_first(const Ref<BTTask> &p_root) {
+	return BTTraceRecorder::get_tasks_depth_first(p_root);
+}
 
-	return arr;
+Array BehaviorTreeData::serialize(const Ref<BTInstance> &p_instance) {
+	return BTTraceRecorder::serialize_structure(p_instance.ptr());
 }
 
 Ref<BehaviorTreeData> BehaviorTreeData::deserialize(const Array &p_array) {
@@ -83,6 +53,88 @@ Ref<BehaviorTreeData> BehaviorTreeData::deserialize(const Array &p_array) {
 	return data;
 }
 
+void BehaviorTreeData::append_delta_entry(PackedByteArray &r_delta, int p_task_index, int p_status, int p_status_flags, float p_elapsed_time) {
+	const uint32_t header = (uint32_t(p_task_index) << 5) | ((uint32_t(p_status_flags) & 7) << 2) | (uint32_t(p_status) & 3);
+	const int64_t offset = r_delta.size();
+	r_delta.resize(offset + DELTA_ENTRY_SIZE);
+	uint8_t *w = r_delta.ptrw() + offset;
+	memcpy(w, &header, sizeof(uint32_t));
+	memcpy(w + sizeof(uint32_t), &p_elapsed_time, sizeof(float));
+}
+
+bool BehaviorTreeData::apply_delta(const PackedByteArray &p_delta) {
+	ERR_FAIL_COND_V(p_delta.size() % DELTA_ENTRY_SIZE != 0, false);
+	const uint8_t *r = p_delta.ptr();
+	TaskData *w = tasks.ptrw();
+	for (int64_t offset = 0; offset < p_delta.size(); offset += DELTA_ENTRY_SIZE) {
+		uint32_t header;
+		float elapsed_time;
+		memcpy(&header, r + offset, sizeof(uint32_t));
+		memcpy(&elapsed_time, r + offset + sizeof(uint32_t), sizeof(float));
+		const int task_index = header >> 5;
+		ERR_FAIL_INDEX_V(task_index, tasks.size(), false);
+		w[task_index].status = header & 3;
+		w[task_index].status_flags = (header >> 2) & 7;
+		w[task_index].elapsed_time = elapsed_time;
+	}
+	return true;
+}
+
+Ref<BehaviorTreeData> BehaviorTreeData::duplicate_data() const {
+	Ref<BehaviorTreeData> data = memnew(BehaviorTreeData);
+	data->tasks = tasks;
+	data->bt_instance_id = bt_instance_id;
+	data->node_owner_path = node_owner_path;
+	data->source_bt_path = source_bt_path;
+	return data;
+}
+
+Error BehaviorTreeData::decode_trace(const PackedByteArray &p_trace, Ref<BehaviorTreeData> &r_initial, Vector<PackedByteArray> &r_deltas) {
+	Variant decoded = VARIANT_FROM_BYTES(p_trace);
+	ERR_FAIL_COND_V_MSG(decoded.get_type() != Variant::ARRAY, ERR_INVALID_DATA, "BehaviorTreeData: Invalid trace data.");
+	Array data = decoded;
+	ERR_FAIL_COND_V_MSG(data.size() != 3 || int(data[0]) != BTTraceRecorder::TRACE_FORMAT_VERSION, ERR_INVALID_DATA, "BehaviorTreeData: Unsupported trace format.");
+	ERR_FAIL_COND_V(data[1].get_type() != Variant::ARRAY || data[2].get_type() != Variant::PACKED_BYTE_ARRAY, ERR_INVALID_DATA);
+
+	// Structure holds the statuses at dump time.
+	r_initial = deserialize(data[1]);
+	ERR_FAIL_COND_V(r_initial.is_null(), ERR_INVALID_DATA);
+	PackedByteArray events = data[2];
+	ERR_FAIL_COND_V(events.size() % BTTraceRecorder::EVENT_SIZE != 0, ERR_INVALID_DATA);
+	const int num_events = events.size() / BTTraceRecorder::EVENT_SIZE;
+
+	// Roll back to the state before the first recorded event: a task's first event holds its previous status.
+	TaskData *tasks_w = r_initial->tasks.ptrw();
+	Vector<bool> seen;
+	for (int i = 0; i < r_initial->tasks.size(); i++) {
+		seen.push_back(false);
+	}
+	BTTraceRecorder::Event ev;
+	for (int i = 0; i < num_events; i++) {
+		BTTraceRecorder::decode_event(events, i, ev);
+		const int task_index = ev.get_task_index();
+		ERR_FAIL_INDEX_V(task_index, r_initial->tasks.size(), ERR_INVALID_DATA);
+		if (!seen[task_index]) {
+			seen.write[task_index] = true;
+			tasks_w[task_index].status = ev.get_old_status();
+			tasks_w[task_index].elapsed_time = 0.0;
+		}
+	}
+
+	r_deltas.clear();
+	PackedByteArray delta;
+	for (int i = 0; i < num_events; i++) {
+		BTTraceRecorder::decode_event(events, i, ev);
+		append_delta_entry(delta, ev.get_task_index(), ev.get_new_status(), status_to_flag(ev.get_new_status()), ev.elapsed_time);
+		BTTraceRecorder::Event next;
+		if (i + 1 == num_events || (BTTraceRecorder::decode_event(events, i + 1, next) && next.tick != ev.tick)) {
+			r_deltas.push_back(delta);
+			delta = PackedByteArray();
+		}
+	}
+	return OK;
+}
+
 Ref<BehaviorTreeData> BehaviorTreeData::create_from_bt_instance(const Ref<BTInstance> &p_bt_instance) {
 	ERR_FAIL_COND_V_MSG(p_bt_instance.is_null(), nullptr, "Can't create BehaviorTreeData - BTInstance is null.");
 
@@ -92,18 +144,8 @@ Ref<BehaviorTreeData> BehaviorTreeData::create_from_bt_instance(const Ref<BTInst
 	data->node_owner_path = p_bt_instance->get_owner_node() ? p_bt_instance->get_owner_node()->get_path() : NodePath();
 	data->source_bt_path = p_bt_instance->get_source_bt_path();
 
-	// Flatten tree into list depth first
-	List<Ref<BTTask>> stack;
-	stack.push_back(p_bt_instance->get_root_task());
-	while (stack.size()) {
-		Ref<BTTask> task = stack.front()->get();
-		stack.pop_front();
-
-		int num_children = task->get_child_count();
-		for (int i = 0; i < num_children; i++) {
-			stack.push_front(task->get_child(num_children - 1 - i));
-		}
-
+	Vector<Ref<BTTask>> flat_tasks = get_tasks_depth_first(p_bt_instance->get_root_task());
+	for (const Ref<BTTask> &task : flat_tasks) {
 		String script_path;
 		if (task->get_script()) {
 			Ref<Resource> s = task->get_script();
@@ -114,7 +156,7 @@ Ref<BehaviorTreeData> BehaviorTreeData::create_from_bt_instance(const Ref<BTInst
 				task->get_instance_id(),
 				task->get_task_name(),
 				!task->get_custom_name().is_empty(),
-				num_children,
+				task->get_child_count(),
 				task->get_status(),
 				task->get_elapsed_time(),
 				task->get_class(),
@@ -27,6 +27,7 @@ public:
 		bool is_custom_name = false;
 		int num_children = 0;
 		int status = 0;
+		int status_flags = 0; // Statuses observed since the previous update, see `status_to_flag()`.
 		double elapsed_time = 0.0;
 		String type_name;
 		String script_path;
@@ -45,14 +46,29 @@ public:
 		TaskData() {}
 	};
 
-	List<TaskData> tasks;
+	Vector<TaskData> tasks;
 	uint64_t bt_instance_id = 0;
 	NodePath node_owner_path;
 	String source_bt_path;
 
+	// Delta entry: (task index << 5 | status flags << 2 | status) as uint32, followed by elapsed time as float.
+	static constexpr int DELTA_ENTRY_SIZE = 8;
+
 public:
+	_FORCE_INLINE_ static int status_to_flag(int p_status) { return p_status == BTTask::FRESH ? 0 : 1 << (p_status - 1); }
+
+	static Vector<Ref<BTTask>> get_tasks_depth_first(const Ref<BTTask> &p_root);
+
 	static Array serialize(const Ref<BTInstance> &p_instance);
 	static Ref<BehaviorTreeData> deserialize(const Array &p_array);
+
+	static void append_delta_entry(PackedByteArray &r_delta, int p_task_index, int p_status, int p_status_flags, float p_elapsed_time);
+	bool apply_delta(const PackedByteArray &p_delta);
+	Ref<BehaviorTreeData> duplicate_data() const;
+
+	// Decodes a trace from BTInstance::dump_trace() into the initial state and one delta per recorded tick.
+	static Error decode_trace(const PackedByteArray &p_trace, Ref<BehaviorTreeData> &r_initial, Vector<PackedByteArray> &r_deltas);
+
 	static Ref<BehaviorTreeData> create_from_bt_instance(const Ref<BTInstance> &p_bt_instance);
 
 	BehaviorTreeData();
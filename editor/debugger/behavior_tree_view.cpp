@@ -16,6 +16,7 @@
 #include "../../bt/tasks/bt_task.h"
 #include "../../compat/editor_scale.h"
 #include "../../compat/editor_settings.h"
+#include "../../compat/translation.h"
 #include "../../util/limbo_string_names.h"
 #include "../../util/limbo_utility.h"
 #include "behavior_tree_data.h"
@@ -89,10 +90,44 @@ double BehaviorTreeView::_get_editor_scale() const {
 	}
 }
 
+// Returns the next item in depth-first order.
+inline static TreeItem *_get_next_item(TreeItem *p_item) {
+	if (p_item->get_first_child()) {
+		return p_item->get_first_child();
+	}
+	TreeItem *item = p_item;
+	while (item) {
+		if (item->get_next()) {
+			return item->get_next();
+		}
+		item = item->get_parent();
+	}
+	return nullptr;
+}
+
 inline void _item_set_elapsed_time(TreeItem *p_item, double p_elapsed) {
 	p_item->set_text(2, rtos(Math::snapped(p_elapsed, 0.01)).pad_decimals(2));
 }
 
+inline void _item_set_status_flags(TreeItem *p_item, int p_status, int p_status_flags) {
+	// Statuses that the task went through between updates (when the debugger coalesces ticks).
+	String tooltip;
+	if (p_status_flags & ~BehaviorTreeData::status_to_flag(p_status)) {
+		PackedStringArray seen;
+		if (p_status_flags & BehaviorTreeData::status_to_flag(BTTask::RUNNING)) {
+			seen.push_back(TTR("Running"));
+		}
+		if (p_status_flags & BehaviorTreeData::status_to_flag(BTTask::SUCCESS)) {
+			seen.push_back(TTR("Success"));
+		}
+		if (p_status_flags & BehaviorTreeData::status_to_flag(BTTask::FAILURE)) {
+			seen.push_back(TTR("Failure"));
+		}
+		tooltip = TTR("Since last update:") + " " + String(", ").join(seen);
+	}
+	p_item->set_tooltip_text(1, tooltip);
+}
+
 void BehaviorTreeView::update_tree(const Ref<BehaviorTreeData> &p_data) {
 	ERR_FAIL_COND_MSG(p_data.is_null(), "Invalid data. View won't update.");
 	update_data = p_data;
@@ -107,7 +142,7 @@ void BehaviorTreeView::_update_tree(const Ref<BehaviorTreeData> &p_data) {
 		selected_id = item_get_task_id(tree->get_selected());
 	}
 
-	if (last_root_id != 0 && p_data->tasks.size() > 0 && last_root_id == (uint64_t)p_data->tasks.front()->get().id) {
+	if (last_root_id != 0 && p_data->tasks.size() > 0 && last_root_id == (uint64_t)p_data->tasks[0].id) {
 		// * Update tree.
 		// ! Update routine is built on assumption that the behavior tree does NOT mutate. With little work it could detect mutations.
 
@@ -116,9 +151,9 @@ void BehaviorTreeView::_update_tree(const Ref<BehaviorTreeData> &p_data) {
 		while (item) {
 			ERR_FAIL_COND(idx >= p_data->tasks.size());
 
-			const BTTask::Status current_status = (BTTask::Status)p_data->tasks.get(idx).status;
+			const BTTask::Status current_status = (BTTask::Status)p_data->tasks[idx].status;
 			const BTTask::Status last_status = item_get_task_status(item);
-			const bool status_changed = last_status != p_data->tasks.get(idx).status;
+			const bool status_changed = last_status != p_data->tasks[idx].status;
 
 			if (status_changed) {
 				item->set_metadata(1, current_status);
@@ -138,30 +173,18 @@ void BehaviorTreeView::_update_tree(const Ref<BehaviorTreeData> &p_data) {
 			}
 
 			if (status_changed || current_status == BTTask::RUNNING) {
-				_item_set_elapsed_time(item, p_data->tasks.get(idx).elapsed_time);
-			}
-
-			if (item->get_first_child()) {
-				item = item->get_first_child();
-			} else if (item->get_next()) {
-				item = item->get_next();
-			} else {
-				while (item) {
-					item = item->get_parent();
-					if (item && item->get_next()) {
-						item = item->get_next();
-						break;
-					}
-				}
+				_item_set_elapsed_time(item, p_data->tasks[idx].elapsed_time);
 			}
+			_item_set_status_flags(item, current_status, p_data->tasks[idx].status_flags);
 
+			item = _get_next_item(item);
 			idx += 1;
 		}
 		ERR_FAIL_COND(idx != p_data->tasks.size());
 	} else {
 		// * Create new tree.
 
-		last_root_id = p_data->tasks.size() > 0 ? p_data->tasks.front()->get().id : 0;
+		last_root_id = p_data->tasks.size() > 0 ? p_data->tasks[0].id : 0;
 
 		tree->clear();
 		TreeItem *parent = nullptr;
@@ -226,6 +249,43 @@ void BehaviorTreeView::_update_tree(const Ref<BehaviorTreeData> &p_data) {
 	}
 }
 
+void BehaviorTreeView::update_aggregate(const Ref<BehaviorTreeData> &p_structure, const PackedInt32Array &p_counts, int p_num_instances) {
+	ERR_FAIL_COND(p_structure.is_null() || p_structure->tasks.is_empty());
+	ERR_FAIL_COND(p_counts.size() != p_structure->tasks.size() * 3);
+
+	if (last_root_id != p_structure->tasks[0].id) {
+		_update_tree(p_structure);
+	}
+	update_pending = false;
+
+	// Heatmap: hue of the most common status, intensity by the share of instances in which the task is active.
+	const int32_t *counts = p_counts.ptr();
+	TreeItem *item = tree->get_root();
+	for (int idx = 0; item && idx < p_structure->tasks.size(); idx++) {
+		const int running = counts[idx * 3];
+		const int failure = counts[idx * 3 + 1];
+		const int success = counts[idx * 3 + 2];
+		const int active = running + failure + success;
+		if (active == 0 || p_num_instances == 0) {
+			item->clear_custom_bg_color(0);
+			item->set_text(2, "");
+		} else {
+			Color color = theme_cache.color_running;
+			if (success > running && success >= failure) {
+				color = theme_cache.color_success;
+			} else if (failure > running && failure > success) {
+				color = theme_cache.color_failure;
+			}
+			const double share = double(active) / p_num_instances;
+			color.a = 0.1 + 0.5 * share;
+			item->set_custom_bg_color(0, color);
+			item->set_text(2, itos(int64_t(Math::round(share * 100.0))) + "%");
+		}
+		item->set_tooltip_text(2, vformat(TTR("Running: %d\nSuccess: %d\nFailure: %d\nInstances: %d"), running, success, failure, p_num_instances));
+		item = _get_next_item(item);
+	}
+}
+
 void BehaviorTreeView::clear() {
 	tree->clear();
 	collapsed_ids.clear();
@@ -245,6 +305,9 @@ void BehaviorTreeView::_do_update_theme_item_cache() {
 	Color success_fill = Color(success_border, 0.1);
 	Color failure_border = Color::html("#cd3838");
 	Color failure_fill = Color(failure_border, 0.1);
+	theme_cache.color_running = running_border;
+	theme_cache.color_success = success_border;
+	theme_cache.color_failure = failure_border;
 
 	theme_cache.sbf_running.instantiate();
 	theme_cache.sbf_running->set_border_color(running_border);
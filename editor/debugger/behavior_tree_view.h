@@ -46,6 +46,10 @@ private:
 		Ref<Texture2D> icon_failure;
 
 		Ref<Font> font_custom_name;
+
+		Color color_running;
+		Color color_success;
+		Color color_failure;
 	} theme_cache;
 
 	Vector<uint64_t> collapsed_ids;
@@ -76,6 +80,7 @@ protected:
 public:
 	void clear();
 	void update_tree(const Ref<BehaviorTreeData> &p_data);
+	void update_aggregate(const Ref<BehaviorTreeData> &p_structure, const PackedInt32Array &p_counts, int p_num_instances);
 
 	void set_update_interval_msec(int p_milliseconds) { update_interval_msec = p_milliseconds; }
 	int get_update_interval_msec() const { return update_interval_msec; }
@@ -14,9 +14,18 @@
 #include "../../bt/bt_instance.h"
 #include "../../compat/debugger.h"
 #include "../../compat/object.h"
+#include "../../compat/scene_tree.h"
 #include "../../util/limbo_string_names.h"
 #include "behavior_tree_data.h"
 
+#ifdef LIMBOAI_MODULE
+#include "core/os/time.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/time.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
 //**** LimboDebugger
 
 LimboDebugger *LimboDebugger::singleton = nullptr;
@@ -56,11 +65,19 @@ Error LimboDebugger::parse_message(void *p_user, const String &p_msg, const Arra
 		singleton->_track_tree(p_args[0]);
 	} else if (p_msg == "untrack_bt_player") {
 		singleton->_untrack_tree();
+	} else if (p_msg == "track_aggregate") {
+		singleton->_track_aggregate(p_args[0]);
+	} else if (p_msg == "untrack_aggregate") {
+		singleton->_untrack_aggregate();
 	} else if (p_msg == "start_session") {
 		singleton->session_active = true;
 		singleton->_send_active_bt_players();
+	} else if (p_msg == "set_update_interval") {
+		ERR_FAIL_COND_V(p_args.size() != 1, ERR_INVALID_PARAMETER);
+		singleton->update_interval_msec = MAX(0, int(p_args[0]));
 	} else if (p_msg == "stop_session") {
 		singleton->session_active = false;
+		singleton->_untrack_aggregate();
 	} else {
 		r_captured = false;
 	}
@@ -95,7 +112,8 @@ void LimboDebugger::register_bt_instance(uint64_t p_instance_id) {
 
 	active_bt_instances.insert(p_instance_id);
 	if (session_active) {
-		_send_active_bt_players();
+		pending_added_instances.insert(p_instance_id);
+		_schedule_instance_changes();
 	}
 }
 
@@ -110,7 +128,13 @@ void LimboDebugger::unregister_bt_instance(uint64_t p_instance_id) {
 	active_bt_instances.erase(p_instance_id);
 
 	if (session_active) {
-		_send_active_bt_players();
+		if (pending_added_instances.has(p_instance_id)) {
+			// Added and removed within the same frame: the editor never needs to know.
+			pending_added_instances.erase(p_instance_id);
+		} else {
+			pending_removed_instances.push_back(p_instance_id);
+		}
+		_schedule_instance_changes();
 	}
 }
 
@@ -123,8 +147,10 @@ void LimboDebugger::_track_tree(uint64_t p_instance_id) {
 	ERR_FAIL_COND(!active_bt_instances.has(p_instance_id));
 
 	_untrack_tree();
+	_untrack_aggregate();
 
 	tracked_instance_id = p_instance_id;
+	tracked_structure_sent = false;
 
 	BTInstance *inst = Object::cast_to<BTInstance>(OBJECT_DB_GET_INSTANCE(p_instance_id));
 	ERR_FAIL_NULL(inst);
@@ -140,10 +166,150 @@ void LimboDebugger::_untrack_tree() {
 	if (inst) {
 		inst->disconnect(LW_NAME(updated), callable_mp(this, &LimboDebugger::_on_bt_instance_updated));
 	}
+	_set_tracked_delta_pending(false);
 	tracked_instance_id = 0;
+	tracked_tasks.clear();
+	tracked_structure_sent = false;
+}
+
+void LimboDebugger::_track_aggregate(uint64_t p_instance_id) {
+	ERR_FAIL_COND(!active_bt_instances.has(p_instance_id));
+	BTInstance *inst = Object::cast_to<BTInstance>(OBJECT_DB_GET_INSTANCE(p_instance_id));
+	ERR_FAIL_NULL(inst);
+	if (inst->get_source_bt_path().is_empty()) {
+		// Instances are grouped by resource path; trees built in code have none and can't be told apart.
+		Array arr;
+		arr.push_back(p_instance_id);
+		EngineDebugger::get_singleton()->send_message("limboai:aggregate_unavailable", arr);
+		return;
+	}
+
+	_untrack_tree();
+	_untrack_aggregate();
+
+	aggregate_bt_path = inst->get_source_bt_path();
+	aggregate_structure_sent = false;
+	last_aggregate_msec = 0;
+	SCENE_TREE()->connect(LW_NAME(process_frame), callable_mp(this, &LimboDebugger::_on_aggregate_frame));
+}
+
+void LimboDebugger::_untrack_aggregate() {
+	if (SCENE_TREE() && SCENE_TREE()->is_connected(LW_NAME(process_frame), callable_mp(this, &LimboDebugger::_on_aggregate_frame))) {
+		SCENE_TREE()->disconnect(LW_NAME(process_frame), callable_mp(this, &LimboDebugger::_on_aggregate_frame));
+	}
+	aggregate_bt_path = String();
+}
+
+void LimboDebugger::_on_aggregate_frame() {
+	// Aggregates are sampled at low frequency: counting visits every task of every instance.
+	uint64_t ticks_msec = Time::get_singleton()->get_ticks_msec();
+	if (last_aggregate_msec != 0 && ticks_msec - last_aggregate_msec < AGGREGATE_SAMPLE_INTERVAL_MSEC) {
+		return;
+	}
+	last_aggregate_msec = ticks_msec;
+	_send_aggregate();
+}
+
+static int _get_task_count(const BTTask *p_task) {
+	int count = 1;
+	for (int i = 0; i < p_task->get_child_count(); i++) {
+		count += _get_task_count(p_task->get_child(i).ptr());
+	}
+	return count;
+}
+
+static void _count_task_statuses(const BTTask *p_task, int32_t *r_counts, int &r_idx) {
+	const int status = p_task->get_status();
+	if (status != BTTask::FRESH) {
+		// Per task: RUNNING, FAILURE and SUCCESS counts.
+		r_counts[r_idx * 3 + status - 1] += 1;
+	}
+	r_idx += 1;
+	for (int i = 0; i < p_task->get_child_count(); i++) {
+		_count_task_statuses(p_task->get_child(i).ptr(), r_counts, r_idx);
+	}
+}
+
+void LimboDebugger::_send_aggregate() {
+	BTInstance *first = nullptr;
+	int num_tasks = 0;
+	int num_instances = 0;
+	PackedInt32Array counts;
+	for (uint64_t instance_id : active_bt_instances) {
+		BTInstance *inst = Object::cast_to<BTInstance>(OBJECT_DB_GET_INSTANCE(instance_id));
+		if (inst == nullptr || !inst->is_instance_valid() || inst->get_source_bt_path() != aggregate_bt_path) {
+			continue;
+		}
+		const BTTask *root = inst->get_root_task().ptr();
+		if (first == nullptr) {
+			first = inst;
+			num_tasks = _get_task_count(root);
+			counts.resize(num_tasks * 3);
+			counts.fill(0);
+		} else if (_get_task_count(root) != num_tasks) {
+			// Tree was modified at runtime; it can't be aggregated with the others.
+			continue;
+		}
+		int idx = 0;
+		_count_task_statuses(root, counts.ptrw(), idx);
+		num_instances += 1;
+	}
+	if (first == nullptr) {
+		return;
+	}
+
+	Array arr;
+	arr.push_back(aggregate_bt_path);
+	// Structure (with names) is sent only with the first sample.
+	arr.push_back(aggregate_structure_sent ? Array() : BehaviorTreeData::serialize(first));
+	arr.push_back(num_instances);
+	arr.push_back(counts);
+	aggregate_structure_sent = true;
+	EngineDebugger::get_singleton()->send_message("limboai:bt_aggregate", arr);
+}
+
+void LimboDebugger::_schedule_instance_changes() {
+	if (!instance_changes_scheduled) {
+		instance_changes_scheduled = true;
+		callable_mp(this, &LimboDebugger::_send_instance_changes).call_deferred();
+	}
+}
+
+void LimboDebugger::_send_instance_changes() {
+	instance_changes_scheduled = false;
+	if (!session_active || (pending_added_instances.is_empty() && pending_removed_instances.is_empty())) {
+		return;
+	}
+
+	// Owner paths are resolved here rather than on registration, when owners may not be inside the tree yet.
+	Array added;
+	for (uint64_t instance_id : pending_added_instances) {
+		BTInstance *inst = Object::cast_to<BTInstance>(OBJECT_DB_GET_INSTANCE(instance_id));
+		if (inst == nullptr) {
+			continue;
+		}
+		Node *owner_node = inst->get_owner_node();
+		added.append(instance_id);
+		added.append(owner_node ? owner_node->get_path() : NodePath());
+	}
+	Array removed;
+	for (uint64_t instance_id : pending_removed_instances) {
+		removed.append(instance_id);
+	}
+	pending_added_instances.clear();
+	pending_removed_instances.clear();
+
+	Array arr;
+	arr.push_back(added);
+	arr.push_back(removed);
+	EngineDebugger::get_singleton()->send_message("limboai:bt_players_changed", arr);
 }
 
 void LimboDebugger::_send_active_bt_players() {
+	// The full list supersedes any pending changes.
+	pending_added_instances.clear();
+	pending_removed_instances.clear();
+
 	Array arr;
 	for (uint64_t instance_id : active_bt_instances) {
 		arr.append(instance_id);
@@ -158,14 +324,97 @@ void LimboDebugger::_send_active_bt_players() {
 	EngineDebugger::get_singleton()->send_message("limboai:active_bt_players", arr);
 }
 
+void LimboDebugger::_send_tracked_structure(BTInstance *p_instance) {
+	// Tree structure and names are sent once; subsequent updates only carry changed statuses.
+	Array arr = BehaviorTreeData::serialize(p_instance);
+	EngineDebugger::get_singleton()->send_message("limboai:bt_structure", arr);
+
+	tracked_tasks.clear();
+	Vector<Ref<BTTask>> tasks = BehaviorTreeData::get_tasks_depth_first(p_instance->get_root_task());
+	for (const Ref<BTTask> &task : tasks) {
+		tracked_tasks.push_back({ task, task->get_status(), 0, float(task->get_elapsed_time()) });
+	}
+	tracked_structure_sent = true;
+	last_delta_msec = Time::get_singleton()->get_ticks_msec();
+}
+
+void LimboDebugger::_record_tracked_statuses() {
+	TrackedTask *tasks = tracked_tasks.ptrw();
+	for (int i = 0; i < tracked_tasks.size(); i++) {
+		tasks[i].seen_flags |= BehaviorTreeData::status_to_flag(tasks[i].task->get_status());
+	}
+}
+
+void LimboDebugger::_send_tracked_delta() {
+	PackedByteArray delta;
+	TrackedTask *tasks = tracked_tasks.ptrw();
+	for (int i = 0; i < tracked_tasks.size(); i++) {
+		const int status = tasks[i].task->get_status();
+		const int status_flags = tasks[i].seen_flags | BehaviorTreeData::status_to_flag(status);
+		const float elapsed_time = tasks[i].task->get_elapsed_time();
+		// Also report tasks that went through other statuses since the last message, even if they ended up unchanged.
+		const bool had_other_status = (status_flags & ~BehaviorTreeData::status_to_flag(status)) != 0;
+		if (status != tasks[i].status || elapsed_time != tasks[i].elapsed_time || had_other_status) {
+			tasks[i].status = status;
+			tasks[i].elapsed_time = elapsed_time;
+			BehaviorTreeData::append_delta_entry(delta, i, status, status_flags, elapsed_time);
+		}
+		tasks[i].seen_flags = 0;
+	}
+	if (delta.is_empty()) {
+		return;
+	}
+	Array arr;
+	arr.push_back(tracked_instance_id);
+	arr.push_back(delta);
+	EngineDebugger::get_singleton()->send_message("limboai:bt_delta", arr);
+}
+
+void LimboDebugger::_set_tracked_delta_pending(bool p_pending) {
+	if (tracked_delta_pending == p_pending) {
+		return;
+	}
+	tracked_delta_pending = p_pending;
+	// While a delta is pending, it is flushed on the next frame past the interval, even if the tree stops updating.
+	if (p_pending) {
+		SCENE_TREE()->connect(LW_NAME(process_frame), callable_mp(this, &LimboDebugger::_on_tracked_frame));
+	} else if (SCENE_TREE() && SCENE_TREE()->is_connected(LW_NAME(process_frame), callable_mp(this, &LimboDebugger::_on_tracked_frame))) {
+		SCENE_TREE()->disconnect(LW_NAME(process_frame), callable_mp(this, &LimboDebugger::_on_tracked_frame));
+	}
+}
+
+void LimboDebugger::_on_tracked_frame() {
+	uint64_t ticks_msec = Time::get_singleton()->get_ticks_msec();
+	if (ticks_msec - last_delta_msec < uint64_t(update_interval_msec)) {
+		return;
+	}
+	last_delta_msec = ticks_msec;
+	_set_tracked_delta_pending(false);
+	_send_tracked_delta();
+}
+
 void LimboDebugger::_on_bt_instance_updated(int _status, uint64_t p_instance_id) {
 	if (p_instance_id != tracked_instance_id) {
 		return;
 	}
+	if (tracked_structure_sent) {
+		if (update_interval_msec > 0) {
+			// Rate-limited: coalesce statuses of skipped ticks into flags of the next message.
+			uint64_t ticks_msec = Time::get_singleton()->get_ticks_msec();
+			if (ticks_msec - last_delta_msec < uint64_t(update_interval_msec)) {
+				_record_tracked_statuses();
+				_set_tracked_delta_pending(true);
+				return;
+			}
+			last_delta_msec = ticks_msec;
+		}
+		_set_tracked_delta_pending(false);
+		_send_tracked_delta();
+		return;
+	}
 	BTInstance *inst = Object::cast_to<BTInstance>(OBJECT_DB_GET_INSTANCE(p_instance_id));
 	ERR_FAIL_NULL(inst);
-	Array arr = BehaviorTreeData::serialize(inst);
-	EngineDebugger::get_singleton()->send_message("limboai:bt_update", arr);
+	_send_tracked_structure(inst);
 }
 
 #endif // ! DEBUG_ENABLED
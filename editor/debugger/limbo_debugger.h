@@ -12,6 +12,8 @@
 #ifndef LIMBO_DEBUGGER_H
 #define LIMBO_DEBUGGER_H
 
+#include "../../bt/tasks/bt_task.h"
+
 #ifdef LIMBOAI_MODULE
 #include "core/object/class_db.h"
 #include "core/object/object.h"
@@ -24,6 +26,8 @@
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
 
+class BTInstance;
+
 class LimboDebugger : public Object {
 	GDCLASS(LimboDebugger, Object);
 
@@ -44,13 +48,48 @@ protected:
 
 #ifdef DEBUG_ENABLED
 private:
+	static constexpr int AGGREGATE_SAMPLE_INTERVAL_MSEC = 500;
+
+	// Last sent state of a task in the tracked tree, in depth-first order.
+	struct TrackedTask {
+		Ref<BTTask> task;
+		int status = 0;
+		int seen_flags = 0; // Statuses observed since the last message.
+		float elapsed_time = 0.0;
+	};
+
 	HashSet<uint64_t> active_bt_instances;
+	// Registration changes are batched and sent once per frame.
+	HashSet<uint64_t> pending_added_instances;
+	Vector<uint64_t> pending_removed_instances;
+	bool instance_changes_scheduled = false;
 	uint64_t tracked_instance_id = 0;
+	Vector<TrackedTask> tracked_tasks;
+	bool tracked_structure_sent = false;
+	bool tracked_delta_pending = false; // Statuses changed since the last rate-limited message.
+	uint64_t last_delta_msec = 0;
+	int update_interval_msec = 0; // Requested by the editor; limits how often deltas are sent.
 	bool session_active = false;
 
+	// Aggregate mode: status counts across all instances of one BehaviorTree.
+	String aggregate_bt_path;
+	bool aggregate_structure_sent = false;
+	uint64_t last_aggregate_msec = 0;
+
 	void _track_tree(uint64_t p_instance_id);
 	void _untrack_tree();
 	void _send_active_bt_players();
+	void _schedule_instance_changes();
+	void _send_instance_changes();
+	void _send_tracked_structure(BTInstance *p_instance);
+	void _track_aggregate(uint64_t p_instance_id);
+	void _untrack_aggregate();
+	void _on_aggregate_frame();
+	void _send_aggregate();
+	void _record_tracked_statuses();
+	void _send_tracked_delta();
+	void _set_tracked_delta_pending(bool p_pending);
+	void _on_tracked_frame();
 
 	void _on_bt_instance_updated(int status, uint64_t p_instance_id);
 
@@ -26,6 +26,8 @@
 
 #ifdef LIMBOAI_MODULE
 #include "core/io/config_file.h"
+#include "core/io/file_access.h"
+#include "core/templates/hash_set.h"
 #include "editor/docks/filesystem_dock.h"
 #include "scene/gui/separator.h"
 #include "scene/gui/tab_container.h"
@@ -33,9 +35,11 @@
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/config_file.hpp>
+#include <godot_cpp/classes/file_access.hpp>
 #include <godot_cpp/classes/file_system_dock.hpp>
 #include <godot_cpp/classes/tab_container.hpp>
 #include <godot_cpp/classes/v_separator.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
 #endif // LIMBOAI_GDEXTENSION
 
 //**** LimboDebuggerTab
@@ -43,6 +47,9 @@
 void LimboDebuggerTab::_reset_controls() {
 	bt_instance_list->clear();
 	bt_view->clear();
+	tracked_data.unref();
+	aggregate_structure.unref();
+	_clear_history();
 	alert_box->hide();
 	info_message->set_text(TTR("Run project to start debugging."));
 	info_message->show();
@@ -53,10 +60,12 @@ void LimboDebuggerTab::_reset_controls() {
 void LimboDebuggerTab::start_session() {
 	bt_instance_list->clear();
 	bt_view->clear();
+	tracked_data.unref();
 	alert_box->hide();
 	info_message->set_text(TTR("Pick a player from the list to display behavior tree."));
 	info_message->show();
 	session->send_message("limboai:start_session", Array());
+	_update_interval_changed(update_interval->get_value());
 }
 
 void LimboDebuggerTab::stop_session() {
@@ -74,6 +83,47 @@ void LimboDebuggerTab::update_active_bt_instances(const Array &p_data) {
 	_update_bt_instance_list(active_bt_instances, filter_players->get_text());
 }
 
+void LimboDebuggerTab::update_bt_instance_changes(const Array &p_data) {
+	ERR_FAIL_COND(p_data.size() != 2);
+	const Array added = p_data[0];
+	const Array removed = p_data[1];
+
+	// Apply changes to the list in place, instead of rebuilding it.
+	if (!removed.is_empty()) {
+		HashSet<uint64_t> removed_ids;
+		for (int i = 0; i < removed.size(); i++) {
+			removed_ids.insert(uint64_t(removed[i]));
+		}
+
+		Vector<BTInstanceInfo> remaining;
+		for (const BTInstanceInfo &info : active_bt_instances) {
+			if (!removed_ids.has(info.instance_id)) {
+				remaining.push_back(info);
+			}
+		}
+		active_bt_instances = remaining;
+
+		uint64_t selected_instance_id = get_selected_bt_instance_id();
+		for (int i = bt_instance_list->get_item_count() - 1; i >= 0; i--) {
+			if (removed_ids.has(uint64_t(bt_instance_list->get_item_metadata(i)))) {
+				bt_instance_list->remove_item(i);
+			}
+		}
+		if (selected_instance_id != 0 && removed_ids.has(selected_instance_id)) {
+			_show_alert(TTR("Behavior tree instance is no longer present."));
+		}
+	}
+
+	String filter = filter_players->get_text().to_lower();
+	for (int i = 0; i + 1 < added.size(); i += 2) {
+		BTInstanceInfo info{ added[i], added[i + 1] };
+		active_bt_instances.push_back(info);
+		if (filter.is_empty() || info.owner_node_path.to_lower().contains(filter)) {
+			_add_bt_instance_item(info);
+		}
+	}
+}
+
 uint64_t LimboDebuggerTab::get_selected_bt_instance_id() {
 	if (!bt_instance_list->is_anything_selected()) {
 		return 0;
@@ -82,12 +132,138 @@ uint64_t LimboDebuggerTab::get_selected_bt_instance_id() {
 }
 
 void LimboDebuggerTab::update_behavior_tree(const Ref<BehaviorTreeData> &p_data) {
+	tracked_data = p_data;
+	_clear_history();
+	history_base = p_data->duplicate_data();
 	resource_header->set_text(p_data->source_bt_path);
 	resource_header->set_disabled(false);
 	bt_view->update_tree(p_data);
 	info_message->hide();
 }
 
+void LimboDebuggerTab::update_behavior_tree_delta(uint64_t p_instance_id, const PackedByteArray &p_delta) {
+	if (tracked_data.is_null() || tracked_data->bt_instance_id != p_instance_id) {
+		return;
+	}
+	if (!tracked_data->apply_delta(p_delta)) {
+		return;
+	}
+
+	bool trimmed = _push_history(p_delta);
+
+	if (pause_button->is_pressed()) {
+		// Keep recording, but leave the view at the inspected position.
+		double position = history_slider->get_value();
+		history_slider->set_max(history_count);
+		if (trimmed && position > 0.0) {
+			// Entries shifted by one.
+			history_slider->set_value_no_signal(position - 1.0);
+		} else if (trimmed) {
+			// The inspected state was dropped; show the oldest recorded one.
+			_history_position_changed(0.0);
+		}
+	} else {
+		bt_view->update_tree(tracked_data);
+	}
+}
+
+bool LimboDebuggerTab::_push_history(const PackedByteArray &p_delta) {
+	if (history.is_empty()) {
+		history.resize(MAX_HISTORY_SIZE);
+	}
+	if (history_count < history.size()) {
+		history.write[(history_head + history_count) % history.size()] = p_delta;
+		history_count += 1;
+		return false;
+	}
+	// Full: the oldest delta is merged into the base state and its slot is reused.
+	history_base->apply_delta(history[history_head]);
+	history.write[history_head] = p_delta;
+	history_head = (history_head + 1) % history.size();
+	return true;
+}
+
+void LimboDebuggerTab::_clear_history() {
+	history.clear();
+	history_head = 0;
+	history_count = 0;
+	history_base.unref();
+	history_slider->set_max(0);
+}
+
+void LimboDebuggerTab::_update_interval_changed(double p_value) {
+	bt_view->set_update_interval_msec(p_value);
+	if (session.is_valid() && session->is_active()) {
+		Array msg_data;
+		msg_data.push_back(int(p_value));
+		session->send_message("limboai:set_update_interval", msg_data);
+	}
+}
+
+void LimboDebuggerTab::_pause_toggled(bool p_paused) {
+	history_slider->set_visible(p_paused);
+	if (p_paused) {
+		history_slider->set_max(history_count);
+		history_slider->set_value_no_signal(history_count);
+	} else if (tracked_data.is_valid()) {
+		bt_view->update_tree(tracked_data);
+	}
+}
+
+void LimboDebuggerTab::_load_trace_pressed() {
+	load_trace_dialog->popup_centered_clamped(Size2i(700, 500), 0.8f);
+}
+
+void LimboDebuggerTab::_load_trace(const String &p_path) {
+	Ref<BehaviorTreeData> initial;
+	Vector<PackedByteArray> deltas;
+	Error err = BehaviorTreeData::decode_trace(FileAccess::get_file_as_bytes(p_path), initial, deltas);
+	if (err != OK) {
+		_show_alert(TTR("Failed to load execution trace."));
+		return;
+	}
+
+	// Stop tracking the live instance: the trace replaces it in the view.
+	if (bt_instance_list->is_anything_selected()) {
+		bt_instance_list->deselect_all();
+		if (session.is_valid() && session->is_active()) {
+			session->send_message(aggregate_button->is_pressed() ? "limboai:untrack_aggregate" : "limboai:untrack_bt_player", Array());
+		}
+	}
+	aggregate_button->set_pressed_no_signal(false);
+	pause_button->set_disabled(false);
+	aggregate_structure.unref();
+	bt_view->clear();
+	tracked_data.unref();
+	history_base = initial;
+	history = deltas;
+	history_head = 0;
+	history_count = deltas.size();
+
+	alert_box->hide();
+	info_message->hide();
+	resource_header->set_text(initial->source_bt_path);
+	resource_header->set_disabled(initial->source_bt_path.is_empty());
+
+	pause_button->set_pressed(true);
+	history_slider->set_max(history_count);
+	history_slider->set_value_no_signal(history_count);
+	_history_position_changed(history_count);
+}
+
+void LimboDebuggerTab::_history_position_changed(double p_position) {
+	if (history_base.is_null()) {
+		return;
+	}
+	// Replay recorded deltas up to the selected position.
+	Ref<BehaviorTreeData> data = history_base->duplicate_data();
+	int position = MIN(int(p_position), history_count);
+	for (int i = 0; i < position; i++) {
+		data->apply_delta(_get_history_entry(i));
+	}
+	bt_view->update_tree(data);
+}
+
 void LimboDebuggerTab::_show_alert(const String &p_message) {
 	alert_message->set_text(p_message);
 	alert_box->set_visible(!p_message.is_empty());
@@ -106,10 +282,7 @@ void LimboDebuggerTab::_update_bt_instance_list(const Vector<BTInstanceInfo> &p_
 	String filter = p_filter.to_lower();
 	for (const BTInstanceInfo &info : p_instances) {
 		if (filter.is_empty() || info.owner_node_path.to_lower().contains(filter)) {
-			int idx = bt_instance_list->add_item(info.owner_node_path);
-			bt_instance_list->set_item_metadata(idx, info.instance_id);
-			// Make item text shortened from the left, e.g ".../Agent/BTPlayer".
-			bt_instance_list->set_item_text_direction(idx, TEXT_DIRECTION_RTL);
+			int idx = _add_bt_instance_item(info);
 			if (info.instance_id == selected_instance_id) {
 				select_idx = idx;
 			}
@@ -123,8 +296,10 @@ void LimboDebuggerTab::_update_bt_instance_list(const Vector<BTInstanceInfo> &p_
 		bt_instance_list->select(select_idx);
 	} else if (selected_instance_id != 0) {
 		if (selection_filtered_out) {
-			session->send_message("limboai:untrack_bt_player", Array());
+			session->send_message(aggregate_button->is_pressed() ? "limboai:untrack_aggregate" : "limboai:untrack_bt_player", Array());
 			bt_view->clear();
+			tracked_data.unref();
+			aggregate_structure.unref();
 			_show_alert("");
 		} else {
 			_show_alert(TTR("Behavior tree instance is no longer present."));
@@ -132,16 +307,80 @@ void LimboDebuggerTab::_update_bt_instance_list(const Vector<BTInstanceInfo> &p_
 	}
 }
 
+int LimboDebuggerTab::_add_bt_instance_item(const BTInstanceInfo &p_info) {
+	int idx = bt_instance_list->add_item(p_info.owner_node_path);
+	bt_instance_list->set_item_metadata(idx, p_info.instance_id);
+	// Make item text shortened from the left, e.g ".../Agent/BTPlayer".
+	bt_instance_list->set_item_text_direction(idx, TEXT_DIRECTION_RTL);
+	return idx;
+}
+
 void LimboDebuggerTab::_bt_instance_selected(int p_idx) {
+	_track_selected_instance();
+}
+
+void LimboDebuggerTab::_track_selected_instance() {
+	uint64_t instance_id = get_selected_bt_instance_id();
+	if (instance_id == 0) {
+		return;
+	}
 	alert_box->hide();
 	bt_view->clear();
+	tracked_data.unref();
+	aggregate_structure.unref();
+	_clear_history();
 	info_message->set_text(TTR("Waiting for behavior tree update."));
 	info_message->show();
 	resource_header->set_text(TTR("Waiting for data"));
 	resource_header->set_disabled(true);
 	Array msg_data;
-	msg_data.push_back(bt_instance_list->get_item_metadata(p_idx));
-	session->send_message("limboai:track_bt_player", msg_data);
+	msg_data.push_back(instance_id);
+	// In aggregate mode, the selected instance picks the BehaviorTree to aggregate.
+	session->send_message(aggregate_button->is_pressed() ? "limboai:track_aggregate" : "limboai:track_bt_player", msg_data);
+}
+
+void LimboDebuggerTab::_aggregate_toggled(bool p_enabled) {
+	pause_button->set_disabled(p_enabled);
+	if (!session.is_valid() || !session->is_active()) {
+		return;
+	}
+	if (!p_enabled) {
+		session->send_message("limboai:untrack_aggregate", Array());
+	}
+	_track_selected_instance();
+}
+
+void LimboDebuggerTab::aggregate_unavailable(uint64_t p_instance_id) {
+	if (!aggregate_button->is_pressed() || p_instance_id != get_selected_bt_instance_id()) {
+		return;
+	}
+	info_message->hide();
+	resource_header->set_text(TTR("No resource"));
+	_show_alert(TTR("Aggregate view requires a behavior tree loaded from a resource file. Trees created in code can only be inspected individually."));
+}
+
+void LimboDebuggerTab::update_aggregate(const Array &p_data) {
+	ERR_FAIL_COND(p_data.size() != 4);
+	if (!aggregate_button->is_pressed()) {
+		return;
+	}
+	Array structure = p_data[1];
+	if (!structure.is_empty()) {
+		aggregate_structure = BehaviorTreeData::deserialize(structure);
+		ERR_FAIL_COND(aggregate_structure.is_null());
+		// Statuses of the sampled instance are not meaningful for the aggregate view.
+		BehaviorTreeData::TaskData *tasks = aggregate_structure->tasks.ptrw();
+		for (int i = 0; i < aggregate_structure->tasks.size(); i++) {
+			tasks[i].status = BTTask::FRESH;
+			tasks[i].elapsed_time = 0.0;
+		}
+		resource_header->set_text(p_data[0]);
+		resource_header->set_disabled(false);
+		info_message->hide();
+	}
+	if (aggregate_structure.is_valid()) {
+		bt_view->update_aggregate(aggregate_structure, p_data[3], p_data[2]);
+	}
 }
 
 void LimboDebuggerTab::_filter_changed(String p_text) {
@@ -173,7 +412,12 @@ void LimboDebuggerTab::_notification(int p_what) {
 			resource_header->connect(LW_NAME(pressed), callable_mp(this, &LimboDebuggerTab::_resource_header_pressed));
 			filter_players->connect(LW_NAME(text_changed), callable_mp(this, &LimboDebuggerTab::_filter_changed));
 			bt_instance_list->connect(LW_NAME(item_selected), callable_mp(this, &LimboDebuggerTab::_bt_instance_selected));
-			update_interval->connect("value_changed", callable_mp(bt_view, &BehaviorTreeView::set_update_interval_msec));
+			update_interval->connect(LW_NAME(value_changed), callable_mp(this, &LimboDebuggerTab::_update_interval_changed));
+			pause_button->connect(LW_NAME(toggled), callable_mp(this, &LimboDebuggerTab::_pause_toggled));
+			history_slider->connect(LW_NAME(value_changed), callable_mp(this, &LimboDebuggerTab::_history_position_changed));
+			load_trace_button->connect(LW_NAME(pressed), callable_mp(this, &LimboDebuggerTab::_load_trace_pressed));
+			aggregate_button->connect(LW_NAME(toggled), callable_mp(this, &LimboDebuggerTab::_aggregate_toggled));
+			load_trace_dialog->connect("file_selected", callable_mp(this, &LimboDebuggerTab::_load_trace));
 
 			Ref<ConfigFile> cf;
 			cf.instantiate();
@@ -193,6 +437,8 @@ void LimboDebuggerTab::_notification(int p_what) {
 		} break;
 		case NOTIFICATION_THEME_CHANGED: {
 			alert_icon->set_texture(get_theme_icon(LW_NAME(StatusWarning), LW_NAME(EditorIcons)));
+			pause_button->set_button_icon(get_theme_icon(LW_NAME(Pause), LW_NAME(EditorIcons)));
+			load_trace_button->set_button_icon(get_theme_icon(LW_NAME(Load), LW_NAME(EditorIcons)));
 			resource_header->set_button_icon(LimboUtility::get_singleton()->get_task_icon("BehaviorTree"));
 		} break;
 	}
@@ -242,6 +488,35 @@ LimboDebuggerTab::LimboDebuggerTab() {
 	update_interval->set_step(1.0);
 	update_interval->set_suffix("ms");
 	update_interval->set_custom_minimum_size(Vector2(100 * EDSCALE, 0));
+	update_interval->set_tooltip_text(TTR("Minimum interval between updates sent by the running project.\nStatuses of skipped ticks are still reported."));
+
+	pause_button = memnew(Button);
+	toolbar->add_child(pause_button);
+	pause_button->set_toggle_mode(true);
+	pause_button->set_flat(true);
+	pause_button->set_focus_mode(FOCUS_NONE);
+	pause_button->set_tooltip_text(TTR("Pause the view. Updates are still recorded and can be inspected with the history slider."));
+
+	load_trace_button = memnew(Button);
+	toolbar->add_child(load_trace_button);
+	load_trace_button->set_flat(true);
+	load_trace_button->set_focus_mode(FOCUS_NONE);
+	load_trace_button->set_tooltip_text(TTR("Load an execution trace saved with BTInstance.save_trace() and replay it."));
+
+	aggregate_button = memnew(Button);
+	toolbar->add_child(aggregate_button);
+	aggregate_button->set_text(TTR("Aggregate"));
+	aggregate_button->set_toggle_mode(true);
+	aggregate_button->set_flat(true);
+	aggregate_button->set_focus_mode(FOCUS_NONE);
+	aggregate_button->set_tooltip_text(TTR("Show a status heatmap across all instances of the selected player's behavior tree, sampled twice per second.\nPercentages show the share of instances in which a task is active.\nOnly available for behavior trees loaded from a resource file."));
+
+	load_trace_dialog = memnew(FileDialog);
+	add_child(load_trace_dialog);
+	load_trace_dialog->set_file_mode(FileDialog::FILE_MODE_OPEN_FILE);
+	load_trace_dialog->set_access(FileDialog::ACCESS_FILESYSTEM);
+	load_trace_dialog->set_title(TTR("Load Execution Trace"));
+	load_trace_dialog->hide();
 
 	VSeparator *sep = memnew(VSeparator);
 	toolbar->add_child(sep);
@@ -272,6 +547,14 @@ LimboDebuggerTab::LimboDebuggerTab() {
 	bt_view->set_v_size_flags(Control::SIZE_EXPAND_FILL);
 	view_box->add_child(bt_view);
 
+	history_slider = memnew(HSlider);
+	history_slider->set_min(0);
+	history_slider->set_max(0);
+	history_slider->set_step(1.0);
+	history_slider->set_tooltip_text(TTR("Recorded updates."));
+	history_slider->hide();
+	view_box->add_child(history_slider);
+
 	alert_box = memnew(HBoxContainer);
 	alert_box->hide();
 	view_box->add_child(alert_box);
@@ -340,11 +623,21 @@ bool LimboDebuggerPlugin::_capture(const String &p_message, const Array &p_data,
 	bool captured = true;
 	if (p_message == "limboai:active_bt_players") {
 		tab->update_active_bt_instances(p_data);
-	} else if (p_message == "limboai:bt_update") {
+	} else if (p_message == "limboai:bt_players_changed") {
+		tab->update_bt_instance_changes(p_data);
+	} else if (p_message == "limboai:bt_structure") {
 		Ref<BehaviorTreeData> data = BehaviorTreeData::deserialize(p_data);
-		if (data->bt_instance_id == tab->get_selected_bt_instance_id()) {
+		if (data.is_valid() && data->bt_instance_id == tab->get_selected_bt_instance_id()) {
 			tab->update_behavior_tree(data);
 		}
+	} else if (p_message == "limboai:bt_aggregate") {
+		tab->update_aggregate(p_data);
+	} else if (p_message == "limboai:aggregate_unavailable") {
+		ERR_FAIL_COND_V(p_data.size() != 1, true);
+		tab->aggregate_unavailable(p_data[0]);
+	} else if (p_message == "limboai:bt_delta") {
+		ERR_FAIL_COND_V(p_data.size() != 2, true);
+		tab->update_behavior_tree_delta(p_data[0], p_data[1]);
 	} else {
 		captured = false;
 	}
@@ -25,10 +25,12 @@
 #include "editor/gui/editor_spin_slider.h"
 #include "editor/gui/window_wrapper.h"
 #include "scene/gui/box_container.h"
+#include "scene/gui/file_dialog.h"
 #include "scene/gui/item_list.h"
 #include "scene/gui/label.h"
 #include "scene/gui/line_edit.h"
 #include "scene/gui/panel_container.h"
+#include "scene/gui/slider.h"
 #include "scene/gui/split_container.h"
 #include "scene/gui/texture_rect.h"
 #endif // LIMBOAI_MODULE
@@ -38,7 +40,9 @@
 #include <godot_cpp/classes/editor_debugger_plugin.hpp>
 #include <godot_cpp/classes/editor_debugger_session.hpp>
 #include <godot_cpp/classes/editor_spin_slider.hpp>
+#include <godot_cpp/classes/file_dialog.hpp>
 #include <godot_cpp/classes/h_box_container.hpp>
+#include <godot_cpp/classes/h_slider.hpp>
 #include <godot_cpp/classes/h_split_container.hpp>
 #include <godot_cpp/classes/item_list.hpp>
 #include <godot_cpp/classes/label.hpp>
@@ -52,12 +56,20 @@ class LimboDebuggerTab : public PanelContainer {
 	GDCLASS(LimboDebuggerTab, PanelContainer);
 
 private:
+	static constexpr int MAX_HISTORY_SIZE = 1000;
+
 	struct BTInstanceInfo {
 		uint64_t instance_id = 0;
 		String owner_node_path;
 	};
 
 	Vector<BTInstanceInfo> active_bt_instances;
+	Ref<BehaviorTreeData> tracked_data; // Last received structure, kept up to date with deltas.
+	Ref<BehaviorTreeData> history_base; // State before the first delta in `history`.
+	Vector<PackedByteArray> history; // Ring buffer of recent deltas, recorded even while paused.
+	int history_head = 0; // Index of the oldest delta.
+	int history_count = 0;
+	Ref<BehaviorTreeData> aggregate_structure;
 	Ref<EditorDebuggerSession> session;
 	VBoxContainer *root_vb = nullptr;
 	HBoxContainer *toolbar = nullptr;
@@ -73,15 +85,31 @@ private:
 	Button *resource_header = nullptr;
 	Button *make_floating = nullptr;
 	EditorSpinSlider *update_interval = nullptr;
+	Button *pause_button = nullptr;
+	Button *load_trace_button = nullptr;
+	Button *aggregate_button = nullptr;
+	FileDialog *load_trace_dialog = nullptr;
+	HSlider *history_slider = nullptr;
 	CompatWindowWrapper *window_wrapper = nullptr;
 
 	void _reset_controls();
 	void _show_alert(const String &p_message);
 	void _update_bt_instance_list(const Vector<BTInstanceInfo> &p_instances, const String &p_filter);
+	int _add_bt_instance_item(const BTInstanceInfo &p_info);
 	void _bt_instance_selected(int p_idx);
 	void _filter_changed(String p_text);
 	void _window_visibility_changed(bool p_visible);
 	void _resource_header_pressed();
+	void _update_interval_changed(double p_value);
+	void _pause_toggled(bool p_paused);
+	void _history_position_changed(double p_position);
+	bool _push_history(const PackedByteArray &p_delta);
+	void _clear_history();
+	_FORCE_INLINE_ const PackedByteArray &_get_history_entry(int p_idx) const { return history[(history_head + p_idx) % history.size()]; }
+	void _load_trace_pressed();
+	void _load_trace(const String &p_path);
+	void _aggregate_toggled(bool p_enabled);
+	void _track_selected_instance();
 
 protected:
 	static void _bind_methods();
@@ -91,9 +119,13 @@ public:
 	void start_session();
 	void stop_session();
 	void update_active_bt_instances(const Array &p_data);
+	void update_bt_instance_changes(const Array &p_data);
 	BehaviorTreeView *get_behavior_tree_view() const { return bt_view; }
 	uint64_t get_selected_bt_instance_id();
 	void update_behavior_tree(const Ref<BehaviorTreeData> &p_data);
+	void update_behavior_tree_delta(uint64_t p_instance_id, const PackedByteArray &p_delta);
+	void update_aggregate(const Array &p_data);
+	void aggregate_unavailable(uint64_t p_instance_id);
 
 	void setup(Ref<EditorDebuggerSession> p_session, CompatWindowWrapper *p_wrapper);
 	LimboDebuggerTab();
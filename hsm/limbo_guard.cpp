@@ -0,0 +1,93 @@
+/**
+ * limbo_guard.cpp
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "limbo_guard.h"
+
+void LimboGuard::set_variable(const StringName &p_variable) {
+	variable = p_variable;
+	emit_changed();
+}
+
+void LimboGuard::set_check_type(LimboUtility::CheckType p_check_type) {
+	check_type = p_check_type;
+	emit_changed();
+}
+
+void LimboGuard::set_value(const Variant &p_value) {
+	value = p_value;
+	_compile();
+	emit_changed();
+}
+
+void LimboGuard::_compile() {
+	switch (value.get_type()) {
+		case Variant::INT: {
+			kernel = KERNEL_INT;
+			int_value = value;
+			float_value = value;
+		} break;
+		case Variant::FLOAT: {
+			kernel = KERNEL_FLOAT;
+			float_value = value;
+		} break;
+		case Variant::BOOL: {
+			kernel = KERNEL_BOOL;
+			int_value = bool(value);
+		} break;
+		default: {
+			kernel = KERNEL_GENERIC;
+		} break;
+	}
+}
+
+bool LimboGuard::is_satisfied(const Blackboard *p_blackboard) const {
+	ERR_FAIL_NULL_V(p_blackboard, false);
+	const Variant left = p_blackboard->get_var(variable, Variant(), false);
+	const Variant::Type left_type = left.get_type();
+
+	switch (kernel) {
+		case KERNEL_INT: {
+			if (left_type == Variant::INT) {
+				return _compare<int64_t>(check_type, left, int_value);
+			} else if (left_type == Variant::FLOAT) {
+				return _compare<double>(check_type, left, float_value);
+			}
+		} break;
+		case KERNEL_FLOAT: {
+			if (left_type == Variant::FLOAT || left_type == Variant::INT) {
+				return _compare<double>(check_type, left, float_value);
+			}
+		} break;
+		case KERNEL_BOOL: {
+			if (left_type == Variant::BOOL) {
+				return _compare<int64_t>(check_type, bool(left), int_value);
+			}
+		} break;
+		default: {
+		} break;
+	}
+	// Mixed types and other value types use Variant operators.
+	return LimboUtility::get_singleton()->perform_check(check_type, left, value);
+}
+
+void LimboGuard::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_variable", "variable"), &LimboGuard::set_variable);
+	ClassDB::bind_method(D_METHOD("get_variable"), &LimboGuard::get_variable);
+	ClassDB::bind_method(D_METHOD("set_check_type", "check_type"), &LimboGuard::set_check_type);
+	ClassDB::bind_method(D_METHOD("get_check_type"), &LimboGuard::get_check_type);
+	ClassDB::bind_method(D_METHOD("set_value", "value"), &LimboGuard::set_value);
+	ClassDB::bind_method(D_METHOD("get_value"), &LimboGuard::get_value);
+	ClassDB::bind_method(D_METHOD("evaluate", "blackboard"), &LimboGuard::evaluate);
+
+	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "variable"), "set_variable", "get_variable");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "check_type", PROPERTY_HINT_ENUM, "Equal,Less Than,Less Than Or Equal,Greater Than,Greater Than Or Equal,Not Equal"), "set_check_type", "get_check_type");
+	ADD_PROPERTY(PropertyInfo(Variant::NIL, "value", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_NIL_IS_VARIANT), "set_value", "get_value");
+}
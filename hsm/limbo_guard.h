@@ -0,0 +1,86 @@
+/**
+ * limbo_guard.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef LIMBO_GUARD_H
+#define LIMBO_GUARD_H
+
+#include "../blackboard/blackboard.h"
+#include "../util/limbo_utility.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/io/resource.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/resource.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+// Declarative guard condition: compares a blackboard variable against a value.
+class LimboGuard : public Resource {
+	GDCLASS(LimboGuard, Resource);
+
+private:
+	// Comparison kernel selected from the type of the value.
+	enum Kernel : unsigned int {
+		KERNEL_GENERIC,
+		KERNEL_INT,
+		KERNEL_FLOAT,
+		KERNEL_BOOL,
+	};
+
+	StringName variable;
+	LimboUtility::CheckType check_type = LimboUtility::CheckType::CHECK_EQUAL;
+	Variant value;
+
+	Kernel kernel = KERNEL_GENERIC;
+	int64_t int_value = 0;
+	double float_value = 0.0;
+
+	void _compile();
+
+	template <typename T>
+	static _FORCE_INLINE_ bool _compare(LimboUtility::CheckType p_check_type, T p_left, T p_right) {
+		switch (p_check_type) {
+			case LimboUtility::CheckType::CHECK_EQUAL:
+				return p_left == p_right;
+			case LimboUtility::CheckType::CHECK_LESS_THAN:
+				return p_left < p_right;
+			case LimboUtility::CheckType::CHECK_LESS_THAN_OR_EQUAL:
+				return p_left <= p_right;
+			case LimboUtility::CheckType::CHECK_GREATER_THAN:
+				return p_left > p_right;
+			case LimboUtility::CheckType::CHECK_GREATER_THAN_OR_EQUAL:
+				return p_left >= p_right;
+			case LimboUtility::CheckType::CHECK_NOT_EQUAL:
+				return p_left != p_right;
+			default:
+				return false;
+		}
+	}
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_variable(const StringName &p_variable);
+	StringName get_variable() const { return variable; }
+
+	void set_check_type(LimboUtility::CheckType p_check_type);
+	LimboUtility::CheckType get_check_type() const { return check_type; }
+
+	void set_value(const Variant &p_value);
+	Variant get_value() const { return value; }
+
+	bool is_satisfied(const Blackboard *p_blackboard) const;
+	bool evaluate(const Ref<Blackboard> &p_blackboard) const { return is_satisfied(p_blackboard.ptr()); }
+};
+
+#endif // LIMBO_GUARD_H
@@ -11,8 +11,50 @@
 
 #include "limbo_hsm.h"
 
+#include "limbo_hsm_scheduler.h"
+
+#include "../compat/variant.h"
+#include "../util/limbo_profiler.h"
+
 VARIANT_ENUM_CAST(LimboHSM::UpdateMode);
 
+void LimboHSM::set_update_mode(UpdateMode p_mode) {
+	update_mode = p_mode;
+	_update_scheduling();
+}
+
+void LimboHSM::set_batch_update(bool p_batch_update) {
+	batch_update = p_batch_update;
+	_update_scheduling();
+}
+
+void LimboHSM::_update_scheduling() {
+	bool should_schedule = batch_update && update_mode != MANUAL && is_active() && is_root() && is_inside_tree();
+	bool physics = update_mode == PHYSICS;
+	if (scheduled && (!should_schedule || scheduled_physics != physics)) {
+		scheduled = false;
+		LimboHSMScheduler::remove_root(this, scheduled_physics);
+	}
+	if (should_schedule && !scheduled) {
+		scheduled = true;
+		scheduled_physics = physics;
+		LimboHSMScheduler::add_root(this, physics);
+	}
+	_update_node_processing();
+}
+
+void LimboHSM::_update_node_processing() {
+	LimboState::_update_node_processing();
+	if (is_active() && is_root()) {
+		// Root HSM needs process notifications to drive updates, unless the scheduler drives them.
+		if (!scheduled && update_mode == IDLE) {
+			set_process(true);
+		} else if (!scheduled && update_mode == PHYSICS) {
+			set_physics_process(true);
+		}
+	}
+}
+
 void LimboHSM::set_active(bool p_active) {
 	ERR_FAIL_COND_MSG(agent == nullptr, "LimboHSM is not initialized.");
 	ERR_FAIL_COND_MSG(p_active && initial_state == nullptr, "LimboHSM has no initial substate candidate.");
@@ -37,13 +79,19 @@ void LimboHSM::change_active_state(LimboState *p_state) {
 	ERR_FAIL_COND_MSG(!is_active(), "LimboHSM: Unable to change active state when HSM is not active.");
 	ERR_FAIL_COND_MSG(p_state->get_parent() != this, "LimboHSM: Unable to perform transition to a state that is not a child of this HSM.");
 
+	if (unlikely(LimboProfiler::is_active())) {
+		LimboProfiler::add_instant("hsm", vformat("%s: %s -> %s", get_name(), active_state ? String(active_state->get_name()) : String("<none>"), p_state->get_name()));
+	}
+
 	if (active_state) {
 		active_state->_exit();
 		previous_active = active_state;
 	}
 
-	active_state = p_state;
+	_set_active_state(p_state);
+	pending_condition_target = nullptr;
 	active_state->_enter();
+	_update_active_path();
 
 	emit_signal(LW_NAME(active_state_changed), active_state, previous_active);
 }
@@ -55,13 +103,22 @@ void LimboHSM::_enter() {
 
 	LimboState::_enter();
 	change_active_state(initial_state);
+	_update_scheduling();
 }
 
 void LimboHSM::_exit() {
 	ERR_FAIL_COND(active_state == nullptr);
 	active_state->_exit();
-	active_state = nullptr;
+	_set_active_state(nullptr);
+	_update_active_path();
+	pending_condition_target = nullptr;
+	conditions_evaluated = false;
 	LimboState::_exit();
+	_update_scheduling();
+	if (is_root() && has_queued_events.is_set()) {
+		// Pending events belong to the previous run.
+		clear_event_queue();
+	}
 }
 
 void LimboHSM::_update(double p_delta) {
@@ -75,7 +132,111 @@ void LimboHSM::_update(double p_delta) {
 	}
 }
 
+void LimboHSM::post_event(const StringName &p_event, const Variant &p_cargo) {
+	ERR_FAIL_COND_MSG(p_event == StringName(), "LimboHSM: Unable to post an event with an empty name.");
+
+	if (!is_root()) {
+		// Events are processed by the root HSM only.
+		LimboHSM *root_hsm = Object::cast_to<LimboHSM>(get_root());
+		ERR_FAIL_NULL_MSG(root_hsm, "LimboHSM: Unable to post an event: root state is not a LimboHSM.");
+		root_hsm->post_event(p_event, p_cargo);
+		return;
+	}
+
+	LIMBO_MUTEX_LOCK(event_queue_mutex);
+	if (coalesce_events) {
+		const int *idx = queued_event_indices.getptr(p_event);
+		if (idx) {
+			// Duplicate event: keep the original position, but use the latest cargo.
+			event_queue.write[*idx].cargo = p_cargo;
+			return;
+		}
+		queued_event_indices.insert(p_event, event_queue.size());
+	}
+	event_queue.push_back({ p_event, p_cargo });
+	has_queued_events.set();
+}
+
+void LimboHSM::clear_event_queue() {
+	LIMBO_MUTEX_LOCK(event_queue_mutex);
+	event_queue.clear();
+	queued_event_indices.clear();
+	has_queued_events.clear();
+}
+
+void LimboHSM::_process_event_queue() {
+	Vector<QueuedEvent> events;
+	{
+		LIMBO_MUTEX_LOCK(event_queue_mutex);
+		events = event_queue;
+		event_queue.clear();
+		queued_event_indices.clear();
+		has_queued_events.clear();
+	}
+	for (int i = 0; i < events.size(); i++) {
+		if (!is_active()) {
+			break;
+		}
+		_dispatch(events[i].event, events[i].cargo);
+	}
+}
+
+LimboState *LimboHSM::_find_condition_target() {
+	if (unlikely(transitions_dirty)) {
+		_compile_transitions();
+	}
+	if (compiled_conditions.is_empty()) {
+		return nullptr;
+	}
+	const Blackboard *bb = active_state->blackboard.ptr();
+	for (const CompiledConditionTransition &ct : compiled_conditions) {
+		if (ct.from_state == nullptr) {
+			// Note: Transitions to self are not allowed with ANYSTATE.
+			if (ct.to_state == active_state) {
+				continue;
+			}
+		} else if (ct.from_state != active_state) {
+			continue;
+		}
+		if (ct.guard->is_satisfied(bb)) {
+			return ct.to_state;
+		}
+	}
+	return nullptr;
+}
+
+void LimboHSM::_evaluate_conditions() {
+	// Evaluate each HSM along the active path, from this HSM down to the innermost active HSM.
+	LimboHSM *hsm = this;
+	while (hsm && hsm->active_state) {
+		hsm->pending_condition_target = hsm->_find_condition_target();
+		hsm = hsm->active_hsm;
+	}
+	conditions_evaluated = true;
+}
+
+void LimboHSM::_apply_condition_transitions() {
+	// Outer HSMs first: if an outer transition happens, inner HSMs exit and drop their pending targets.
+	LimboHSM *hsm = this;
+	while (hsm && hsm->is_active()) {
+		LimboState *target = hsm->pending_condition_target;
+		hsm->pending_condition_target = nullptr;
+		if (target && target->get_parent() == hsm && target->_is_entry_permitted()) {
+			hsm->change_active_state(target);
+		}
+		hsm = hsm->active_hsm;
+	}
+}
+
 void LimboHSM::update(double p_delta) {
+	if (has_queued_events.is_set()) {
+		_process_event_queue();
+	}
+	if (!conditions_evaluated && active_state) {
+		_evaluate_conditions();
+	}
+	conditions_evaluated = false;
+	_apply_condition_transitions();
 	updating = true;
 	_update(p_delta);
 	updating = false;
@@ -83,6 +244,9 @@ void LimboHSM::update(double p_delta) {
 		change_active_state(next_active);
 		next_active = nullptr;
 	}
+	if (get_blackboard().is_valid()) {
+		get_blackboard()->flush_scope_changes();
+	}
 }
 
 void LimboHSM::add_transition(LimboState *p_from_state, LimboState *p_to_state, const StringName &p_event, const Callable &p_guard) {
@@ -100,6 +264,17 @@ void LimboHSM::add_transition(LimboState *p_from_state, LimboState *p_to_state,
 		p_event,
 		p_guard
 	};
+	transitions_dirty = true;
+}
+
+void LimboHSM::add_native_transition(LimboState *p_from_state, LimboState *p_to_state, const StringName &p_event, LimboState::NativeGuardFunc p_guard, void *p_userdata) {
+	ERR_FAIL_COND_MSG(has_transition(p_from_state, p_event), "LimboHSM: Unable to add another transition with the same event and origin.");
+	add_transition(p_from_state, p_to_state, p_event);
+	Transition *transition = transitions.getptr(Transition::make_key(p_from_state, p_event));
+	if (transition && p_guard) {
+		transition->native_guard = p_guard;
+		transition->native_guard_userdata = p_userdata;
+	}
 }
 
 void LimboHSM::remove_transition(LimboState *p_from_state, const StringName &p_event) {
@@ -109,27 +284,232 @@ void LimboHSM::remove_transition(LimboState *p_from_state, const StringName &p_e
 	TransitionKey key = Transition::make_key(p_from_state, p_event);
 	ERR_FAIL_COND_MSG(!transitions.has(key), "LimboHSM: Unable to remove a transition that does not exist.");
 	transitions.erase(key);
+	transitions_dirty = true;
 }
 
-void LimboHSM::_get_transition(LimboState *p_from_state, const StringName &p_event, Transition &r_transition) const {
-	ERR_FAIL_COND_MSG(p_from_state != nullptr && p_from_state->get_parent() != this, "LimboHSM: Unable to get a transition from a state that is not an immediate child of this HSM.");
-	ERR_FAIL_COND_MSG(p_event == StringName(), "LimboHSM: Unable to get a transition with an empty event string.");
+void LimboHSM::add_condition_transition(LimboState *p_from_state, LimboState *p_to_state, const Ref<LimboGuard> &p_guard) {
+	ERR_FAIL_COND_MSG(p_from_state != nullptr && p_from_state->get_parent() != this, "LimboHSM: Unable to add a transition from a state that is not an immediate child of mine.");
+	ERR_FAIL_COND_MSG(p_to_state == nullptr, "LimboHSM: Unable to add a transition to a null state.");
+	ERR_FAIL_COND_MSG(p_to_state->get_parent() != this, "LimboHSM: Unable to add a transition to a state that is not an immediate child of mine.");
+	ERR_FAIL_COND_MSG(p_guard.is_null(), "LimboHSM: Unable to add a condition transition without a guard.");
+	ERR_FAIL_COND_MSG(has_condition_transition(p_from_state, p_to_state), "LimboHSM: Unable to add another condition transition with the same origin and target.");
 
-	TransitionKey key = Transition::make_key(p_from_state, p_event);
-	if (transitions.has(key)) {
-		r_transition = transitions[key];
+	// Note: Explicit ObjectID casting needed for GDExtension.
+	condition_transitions.push_back({ p_from_state != nullptr ? ObjectID(p_from_state->get_instance_id()) : ObjectID(),
+			ObjectID(p_to_state->get_instance_id()),
+			p_guard });
+	transitions_dirty = true;
+}
+
+void LimboHSM::remove_condition_transition(LimboState *p_from_state, LimboState *p_to_state) {
+	ERR_FAIL_NULL(p_to_state);
+	ObjectID from_id = p_from_state != nullptr ? ObjectID(p_from_state->get_instance_id()) : ObjectID();
+	ObjectID to_id = ObjectID(p_to_state->get_instance_id());
+	for (int i = 0; i < condition_transitions.size(); i++) {
+		if (condition_transitions[i].from_state == from_id && condition_transitions[i].to_state == to_id) {
+			condition_transitions.remove_at(i);
+			transitions_dirty = true;
+			return;
+		}
 	}
+	ERR_FAIL_MSG("LimboHSM: Unable to remove a condition transition that does not exist.");
 }
 
-LimboState *LimboHSM::get_leaf_state() const {
-	LimboHSM *hsm = const_cast<LimboHSM *>(this);
-	while (hsm->active_state != nullptr && hsm->active_state->is_class("LimboHSM")) {
-		hsm = Object::cast_to<LimboHSM>(hsm->active_state);
+bool LimboHSM::has_condition_transition(LimboState *p_from_state, LimboState *p_to_state) const {
+	ERR_FAIL_NULL_V(p_to_state, false);
+	ObjectID from_id = p_from_state != nullptr ? ObjectID(p_from_state->get_instance_id()) : ObjectID();
+	ObjectID to_id = ObjectID(p_to_state->get_instance_id());
+	for (const ConditionTransition &t : condition_transitions) {
+		if (t.from_state == from_id && t.to_state == to_id) {
+			return true;
+		}
 	}
-	if (hsm->active_state) {
-		return hsm->active_state;
-	} else {
-		return hsm;
+	return false;
+}
+
+void LimboHSM::_compile_transitions() {
+	event_ids.clear();
+	transition_table.clear();
+	compiled_conditions.clear();
+
+	HashMap<uint64_t, int> rows;
+	int num_rows = 1; // Row 0 is reserved for ANYSTATE.
+	for (int i = 0; i < get_child_count(); i++) {
+		LimboState *c = Object::cast_to<LimboState>(get_child(i));
+		if (c) {
+			c->transition_row = num_rows;
+			rows.insert(uint64_t(c->get_instance_id()), num_rows);
+			num_rows += 1;
+		}
+	}
+
+	for (const KeyValue<TransitionKey, Transition> &kv : transitions) {
+		if (!event_ids.has(kv.value.event)) {
+			event_ids.insert(kv.value.event, event_ids.size());
+		}
+	}
+
+	transition_table.resize(num_rows * event_ids.size());
+	CompiledTransition *table = transition_table.ptrw();
+	for (const KeyValue<TransitionKey, Transition> &kv : transitions) {
+		const Transition &t = kv.value;
+		int row = 0;
+		if (t.from_state != ObjectID()) {
+			const int *from_row = rows.getptr(uint64_t(t.from_state));
+			if (from_row == nullptr) {
+				// Origin state is no longer a child of this HSM.
+				continue;
+			}
+			row = *from_row;
+		}
+		LimboState *to_state = Object::cast_to<LimboState>(OBJECT_DB_GET_INSTANCE(t.to_state));
+		if (to_state == nullptr || !rows.has(uint64_t(t.to_state))) {
+			// Target state was freed or moved to another parent.
+			continue;
+		}
+		CompiledTransition &ct = table[row * event_ids.size() + event_ids[t.event]];
+		ct.to_state = to_state;
+		ct.guard = t.guard;
+		ct.native_guard = t.native_guard;
+		ct.native_guard_userdata = t.native_guard_userdata;
+	}
+
+	// Two passes: transitions from specific states take precedence over ANYSTATE.
+	for (int pass = 0; pass < 2; pass++) {
+		for (const ConditionTransition &t : condition_transitions) {
+			bool is_anystate = t.from_state == ObjectID();
+			if (is_anystate != (pass == 1)) {
+				continue;
+			}
+			if (!is_anystate && !rows.has(uint64_t(t.from_state))) {
+				continue;
+			}
+			LimboState *to_state = Object::cast_to<LimboState>(OBJECT_DB_GET_INSTANCE(t.to_state));
+			if (to_state == nullptr || !rows.has(uint64_t(t.to_state))) {
+				continue;
+			}
+			CompiledConditionTransition ct;
+			ct.from_state = is_anystate ? nullptr : Object::cast_to<LimboState>(OBJECT_DB_GET_INSTANCE(t.from_state));
+			ct.to_state = to_state;
+			ct.guard = t.guard;
+			compiled_conditions.push_back(ct);
+		}
+	}
+
+	transitions_dirty = false;
+}
+
+void LimboHSM::_save_snapshot(Array &r_data) const {
+	LimboState::_save_snapshot(r_data);
+
+	int num_states = 0;
+	int active_idx = -1;
+	int previous_idx = -1;
+	for (int i = 0; i < get_child_count(); i++) {
+		LimboState *c = Object::cast_to<LimboState>(get_child(i));
+		if (c) {
+			active_idx = c == active_state ? num_states : active_idx;
+			previous_idx = c == previous_active ? num_states : previous_idx;
+			num_states += 1;
+		}
+	}
+	r_data.push_back(num_states);
+	r_data.push_back(active_idx);
+	r_data.push_back(previous_idx);
+
+	for (int i = 0; i < get_child_count(); i++) {
+		LimboState *c = Object::cast_to<LimboState>(get_child(i));
+		if (c) {
+			c->_save_snapshot(r_data);
+		}
+	}
+}
+
+bool LimboHSM::_load_snapshot(const Array &p_data, int &r_pos) {
+	if (!LimboState::_load_snapshot(p_data, r_pos)) {
+		return false;
+	}
+	ERR_FAIL_COND_V_MSG(r_pos + 3 > p_data.size(), false, "LimboHSM: Snapshot data is truncated.");
+	int num_states = p_data[r_pos];
+	int active_idx = p_data[r_pos + 1];
+	int previous_idx = p_data[r_pos + 2];
+	r_pos += 3;
+
+	Vector<LimboState *> states;
+	for (int i = 0; i < get_child_count(); i++) {
+		LimboState *c = Object::cast_to<LimboState>(get_child(i));
+		if (c) {
+			states.push_back(c);
+		}
+	}
+	ERR_FAIL_COND_V_MSG(states.size() != num_states, false, vformat("LimboHSM: Snapshot doesn't match the state hierarchy of %s.", this));
+	ERR_FAIL_COND_V_MSG(is_active() && (active_idx < 0 || active_idx >= num_states), false, "LimboHSM: Snapshot has invalid active state.");
+
+	_set_active_state(is_active() ? states[active_idx] : nullptr);
+	previous_active = (previous_idx >= 0 && previous_idx < num_states) ? states[previous_idx] : nullptr;
+	next_active = nullptr;
+	// Condition results were evaluated against the state being replaced.
+	pending_condition_target = nullptr;
+	conditions_evaluated = false;
+
+	for (int i = 0; i < states.size(); i++) {
+		if (!states[i]->_load_snapshot(p_data, r_pos)) {
+			return false;
+		}
+	}
+	// Substates are restored first, so their paths are already up to date.
+	_update_active_path();
+	return true;
+}
+
+PackedByteArray LimboHSM::save_snapshot() const {
+	ERR_FAIL_COND_V_MSG(!is_root(), PackedByteArray(), "LimboHSM: save_snapshot() must be called on the root HSM.");
+	Array data;
+	data.push_back(SNAPSHOT_FORMAT_VERSION);
+	_save_snapshot(data);
+	return VARIANT_TO_BYTES(data);
+}
+
+Error LimboHSM::restore_snapshot(const PackedByteArray &p_snapshot) {
+	ERR_FAIL_COND_V_MSG(!is_root(), ERR_UNAVAILABLE, "LimboHSM: restore_snapshot() must be called on the root HSM.");
+	ERR_FAIL_COND_V_MSG(agent == nullptr, ERR_UNCONFIGURED, "LimboHSM: restore_snapshot() requires an initialized HSM.");
+
+	Variant decoded = VARIANT_FROM_BYTES(p_snapshot);
+	ERR_FAIL_COND_V_MSG(decoded.get_type() != Variant::ARRAY, ERR_INVALID_DATA, "LimboHSM: Invalid snapshot data.");
+	Array data = decoded;
+	ERR_FAIL_COND_V_MSG(data.is_empty() || int(data[0]) != SNAPSHOT_FORMAT_VERSION, ERR_INVALID_DATA, "LimboHSM: Unsupported snapshot format.");
+
+	int pos = 1;
+	bool ok = _load_snapshot(data, pos);
+	// Restore runtime flags so that the HSM keeps updating (or stops) as recorded.
+	is_initiating_update = is_active();
+	clear_event_queue();
+	_update_scheduling();
+	ERR_FAIL_COND_V_MSG(!ok, ERR_INVALID_DATA, "LimboHSM: Failed to restore snapshot - state may be partially restored.");
+	return OK;
+}
+
+void LimboHSM::_set_active_state(LimboState *p_state) {
+	active_state = p_state;
+	active_hsm = Object::cast_to<LimboHSM>(p_state);
+}
+
+void LimboHSM::_update_active_path() {
+	// Rebuild paths of this HSM and of each ancestor HSM that has it as the active state.
+	LimboHSM *hsm = this;
+	while (hsm) {
+		hsm->active_path.clear();
+		if (hsm->active_state) {
+			hsm->active_path.push_back(hsm->active_state);
+			if (hsm->active_hsm) {
+				hsm->active_path.append_array(hsm->active_hsm->active_path);
+			}
+		}
+		if (hsm->is_root()) {
+			break;
+		}
+		LimboHSM *parent_hsm = Object::cast_to<LimboHSM>(hsm->get_parent());
+		hsm = (parent_hsm && parent_hsm->active_state == hsm) ? parent_hsm : nullptr;
 	}
 }
 
@@ -152,45 +532,28 @@ bool LimboHSM::_dispatch(const StringName &p_event, const Variant &p_cargo) {
 	}
 
 	if (!event_consumed && active_state) {
-		LimboState *to_state = nullptr;
-
-		Transition transition;
-		_get_transition(active_state, p_event, transition);
-		if (transition.is_valid() && transition.is_allowed()) {
-			to_state = Object::cast_to<LimboState>(ObjectDB::get_instance(transition.to_state));
+		if (unlikely(transitions_dirty)) {
+			_compile_transitions();
 		}
-		if (to_state == nullptr) {
-			// Get ANYSTATE transition.
-			_get_transition(nullptr, p_event, transition);
-			if (transition.is_valid() && transition.is_allowed()) {
-				to_state = Object::cast_to<LimboState>(ObjectDB::get_instance(transition.to_state));
-				if (to_state == active_state) {
-					// Transitions to self are not allowed with ANYSTATE.
-					to_state = nullptr;
+
+		LimboState *to_state = nullptr;
+		const int *event_id = event_ids.getptr(p_event);
+		if (event_id) {
+			const CompiledTransition &transition = _get_compiled_transition(active_state->transition_row, *event_id);
+			if (transition.to_state && transition.is_allowed()) {
+				to_state = transition.to_state;
+			}
+			if (to_state == nullptr) {
+				// Get ANYSTATE transition.
+				const CompiledTransition &any_transition = _get_compiled_transition(0, *event_id);
+				// Note: Transitions to self are not allowed with ANYSTATE.
+				if (any_transition.to_state && any_transition.to_state != active_state && any_transition.is_allowed()) {
+					to_state = any_transition.to_state;
 				}
 			}
 		}
 		if (to_state != nullptr) {
-			bool permitted = true;
-			if (to_state->guard_callable.is_valid()) {
-				Variant ret;
-
-#ifdef LIMBOAI_MODULE
-				Callable::CallError ce;
-				to_state->guard_callable.callp(nullptr, 0, ret, ce);
-				if (unlikely(ce.error != Callable::CallError::CALL_OK)) {
-					ERR_PRINT_ONCE("LimboHSM: Error calling substate's guard callable: " + Variant::get_callable_error_text(to_state->guard_callable, nullptr, 0, ce));
-				}
-#elif LIMBOAI_GDEXTENSION
-				ret = to_state->guard_callable.call();
-#endif
-
-				if (unlikely(ret.get_type() != Variant::BOOL)) {
-					ERR_PRINT_ONCE(vformat("State guard callable %s returned non-boolean value (%s).", to_state->guard_callable, to_state));
-				} else {
-					permitted = bool(ret);
-				}
-			}
+			bool permitted = to_state->_is_entry_permitted();
 			if (permitted) {
 				if (!updating) {
 					change_active_state(to_state);
@@ -203,7 +566,7 @@ bool LimboHSM::_dispatch(const StringName &p_event, const Variant &p_cargo) {
 		}
 	}
 
-	if (!event_consumed && p_event == EVENT_FINISHED && !(get_parent() && get_parent()->is_class("LimboState"))) {
+	if (!event_consumed && p_event == EVENT_FINISHED && is_root()) {
 		_exit();
 	}
 
@@ -232,6 +595,7 @@ void LimboHSM::_initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard) {
 	}
 
 	LimboState::_initialize(p_agent, p_blackboard);
+	_compile_transitions();
 
 	for (int i = 0; i < get_child_count(); i++) {
 		LimboState *c = Object::cast_to<LimboState>(get_child(i));
@@ -244,8 +608,8 @@ void LimboHSM::_initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard) {
 }
 
 void LimboHSM::_validate_property(PropertyInfo &p_property) const {
-	if (p_property.name == LW_NAME(update_mode) && !is_root()) {
-		// Hide update_mode for non-root HSMs.
+	if ((p_property.name == LW_NAME(update_mode) || p_property.name == LW_NAME(batch_update) || p_property.name == LW_NAME(coalesce_events)) && !is_root()) {
+		// Hide update settings for non-root HSMs.
 		p_property.usage = PROPERTY_USAGE_NONE;
 	}
 }
@@ -264,8 +628,13 @@ void LimboHSM::_notification(int p_what) {
 				// Typically, this happens when the node is re-entered scene repeatedly (such as with object pooling).
 				set_active(true);
 			}
+			_update_scheduling();
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
+			if (scheduled) {
+				scheduled = false;
+				LimboHSMScheduler::remove_root(this, scheduled_physics);
+			}
 			if (is_root()) {
 				// Exit the state machine if the root HSM is no longer in the scene tree (except when being reparented).
 				// This ensures that resources and signal connections are released if active.
@@ -293,13 +662,17 @@ void LimboHSM::_notification(int p_what) {
 				}
 			}
 		} break;
+		case NOTIFICATION_CHILD_ORDER_CHANGED: {
+			// Child states were added, removed or reordered.
+			transitions_dirty = true;
+		} break;
 		case NOTIFICATION_PROCESS: {
-			if (is_initiating_update && update_mode == UpdateMode::IDLE) {
+			if (!scheduled && is_initiating_update && update_mode == UpdateMode::IDLE) {
 				update(get_process_delta_time());
 			}
 		} break;
 		case NOTIFICATION_PHYSICS_PROCESS: {
-			if (is_initiating_update && update_mode == UpdateMode::PHYSICS) {
+			if (!scheduled && is_initiating_update && update_mode == UpdateMode::PHYSICS) {
 				update(get_physics_process_delta_time());
 			}
 		} break;
@@ -309,6 +682,8 @@ void LimboHSM::_notification(int p_what) {
 void LimboHSM::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_update_mode", "mode"), &LimboHSM::set_update_mode);
 	ClassDB::bind_method(D_METHOD("get_update_mode"), &LimboHSM::get_update_mode);
+	ClassDB::bind_method(D_METHOD("set_batch_update", "enable"), &LimboHSM::set_batch_update);
+	ClassDB::bind_method(D_METHOD("get_batch_update"), &LimboHSM::get_batch_update);
 
 	ClassDB::bind_method(D_METHOD("set_initial_state", "state"), &LimboHSM::set_initial_state);
 	ClassDB::bind_method(D_METHOD("get_initial_state"), &LimboHSM::get_initial_state);
@@ -318,9 +693,18 @@ void LimboHSM::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_leaf_state"), &LimboHSM::get_leaf_state);
 	ClassDB::bind_method(D_METHOD("set_active", "active"), &LimboHSM::set_active);
 	ClassDB::bind_method(D_METHOD("update", "delta"), &LimboHSM::update);
+	ClassDB::bind_method(D_METHOD("save_snapshot"), &LimboHSM::save_snapshot);
+	ClassDB::bind_method(D_METHOD("restore_snapshot", "snapshot"), &LimboHSM::restore_snapshot);
+	ClassDB::bind_method(D_METHOD("post_event", "event", "cargo"), &LimboHSM::post_event, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("clear_event_queue"), &LimboHSM::clear_event_queue);
+	ClassDB::bind_method(D_METHOD("set_coalesce_events", "enable"), &LimboHSM::set_coalesce_events);
+	ClassDB::bind_method(D_METHOD("get_coalesce_events"), &LimboHSM::get_coalesce_events);
 	ClassDB::bind_method(D_METHOD("add_transition", "from_state", "to_state", "event", "guard"), &LimboHSM::add_transition, DEFVAL(Callable()));
 	ClassDB::bind_method(D_METHOD("remove_transition", "from_state", "event"), &LimboHSM::remove_transition);
 	ClassDB::bind_method(D_METHOD("has_transition", "from_state", "event"), &LimboHSM::has_transition);
+	ClassDB::bind_method(D_METHOD("add_condition_transition", "from_state", "to_state", "guard"), &LimboHSM::add_condition_transition);
+	ClassDB::bind_method(D_METHOD("remove_condition_transition", "from_state", "to_state"), &LimboHSM::remove_condition_transition);
+	ClassDB::bind_method(D_METHOD("has_condition_transition", "from_state", "to_state"), &LimboHSM::has_condition_transition);
 	ClassDB::bind_method(D_METHOD("anystate"), &LimboHSM::anystate);
 	ClassDB::bind_method(D_METHOD("initialize", "agent", "parent_scope"), &LimboHSM::initialize, Variant());
 	ClassDB::bind_method(D_METHOD("change_active_state", "state"), &LimboHSM::change_active_state);
@@ -330,6 +714,8 @@ void LimboHSM::_bind_methods() {
 	BIND_ENUM_CONSTANT(MANUAL);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "update_mode", PROPERTY_HINT_ENUM, "Idle, Physics, Manual"), "set_update_mode", "get_update_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "batch_update"), "set_batch_update", "get_batch_update");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "coalesce_events"), "set_coalesce_events", "get_coalesce_events");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "ANYSTATE", PROPERTY_HINT_RESOURCE_TYPE, "LimboState", 0), "", "anystate");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "initial_state", PROPERTY_HINT_RESOURCE_TYPE, "LimboState", 0), "set_initial_state", "get_initial_state");
 
@@ -12,13 +12,26 @@
 #ifndef LIMBO_HSM_H
 #define LIMBO_HSM_H
 
+#include "limbo_guard.h"
 #include "limbo_state.h"
 
+#include "../compat/mutex.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/templates/safe_refcount.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/templates/safe_refcount.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
 #define TransitionKey Pair<uint64_t, StringName>
 
 class LimboHSM : public LimboState {
 	GDCLASS(LimboHSM, LimboState);
 
+	static constexpr int SNAPSHOT_FORMAT_VERSION = 2;
+
 public:
 	enum UpdateMode : unsigned int {
 		IDLE, // automatically call update() during NOTIFICATION_PROCESS
@@ -40,11 +53,11 @@ private:
 		ObjectID to_state;
 		StringName event;
 		Callable guard;
+		LimboState::NativeGuardFunc native_guard = nullptr;
+		void *native_guard_userdata = nullptr;
 
 		inline bool is_valid() const { return to_state != ObjectID(); }
 
-		inline bool is_allowed() const { return guard.is_null() || guard.call(); }
-
 		static _FORCE_INLINE_ TransitionKey make_key(LimboState *p_from_state, const StringName &p_event) {
 			return TransitionKey(
 					p_from_state != nullptr ? uint64_t(p_from_state->get_instance_id()) : 0,
@@ -52,26 +65,101 @@ private:
 		}
 	};
 
+	// Entry in the compiled transition table: a direct pointer to the target state.
+	struct CompiledTransition {
+		LimboState *to_state = nullptr;
+		Callable guard;
+		LimboState::NativeGuardFunc native_guard = nullptr;
+		void *native_guard_userdata = nullptr;
+
+		inline bool is_allowed() const {
+			if (native_guard) {
+				return native_guard(to_state, native_guard_userdata);
+			}
+			return guard.is_null() || guard.call();
+		}
+	};
+
+	// Transition taken as soon as the guard condition is satisfied (no event needed).
+	struct ConditionTransition {
+		ObjectID from_state;
+		ObjectID to_state;
+		Ref<LimboGuard> guard;
+	};
+
+	struct CompiledConditionTransition {
+		LimboState *from_state = nullptr; // nullptr for ANYSTATE.
+		LimboState *to_state = nullptr;
+		Ref<LimboGuard> guard;
+	};
+
+	struct QueuedEvent {
+		StringName event;
+		Variant cargo;
+	};
+
 	UpdateMode update_mode;
 	LimboState *initial_state;
 	LimboState *active_state;
 	LimboState *previous_active;
 	LimboState *next_active;
+	LimboHSM *active_hsm = nullptr; // Same as active_state if it's a LimboHSM, otherwise null.
+	Vector<LimboState *> active_path; // Active states from active_state down to the leaf state.
 	bool updating = false;
 	bool was_active = false;
 	bool is_initiating_update = false;
+	bool batch_update = false;
+	bool scheduled = false; // Registered with LimboHSMScheduler.
+	bool scheduled_physics = false;
+	int scheduler_index = -1; // Position in the LimboHSMScheduler list.
+	bool coalesce_events = false;
+
+	// Events posted with post_event(), processed at the start of the next update.
+	LIMBO_MUTEX event_queue_mutex;
+	Vector<QueuedEvent> event_queue;
+	HashMap<StringName, int> queued_event_indices; // Event -> position in `event_queue`; used for coalescing.
+	SafeFlag has_queued_events;
 
 	HashMap<TransitionKey, Transition, TransitionKeyHasher> transitions;
 
-	void _get_transition(LimboState *p_from_state, const StringName &p_event, Transition &r_transition) const;
+	// Compiled from `transitions`: row 0 is ANYSTATE, row N is the child state with `transition_row == N`;
+	// columns are interned event IDs.
+	HashMap<StringName, int> event_ids;
+	Vector<CompiledTransition> transition_table;
+	bool transitions_dirty = true;
+
+	Vector<ConditionTransition> condition_transitions;
+	// Compiled from `condition_transitions`: transitions from specific states first, then ANYSTATE.
+	Vector<CompiledConditionTransition> compiled_conditions;
+	LimboState *pending_condition_target = nullptr; // Result of the last condition evaluation.
+	bool conditions_evaluated = false; // Conditions were already evaluated for the next update.
+
+	void _compile_transitions();
+	_FORCE_INLINE_ const CompiledTransition &_get_compiled_transition(int p_row, int p_event_id) const {
+		return transition_table[p_row * event_ids.size() + p_event_id];
+	}
 	void _exit_if_not_inside_tree();
+	void _update_scheduling();
+	void _set_active_state(LimboState *p_state);
+	void _update_active_path();
+	void _process_event_queue();
+	LimboState *_find_condition_target();
+	void _evaluate_conditions();
+	void _apply_condition_transitions();
 
 protected:
+	friend class LimboHSMScheduler;
+
 	static void _bind_methods();
 
 	void _notification(int p_what);
 	void _validate_property(PropertyInfo &p_property) const;
 
+	virtual void _update_node_processing() override;
+
+	virtual void _save_snapshot(Array &r_data) const override;
+	virtual bool _load_snapshot(const Array &p_data, int &r_pos) override;
+
 	virtual void _initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard) override;
 	virtual bool _dispatch(const StringName &p_event, const Variant &p_cargo = Variant()) override;
 
@@ -80,16 +168,20 @@ protected:
 	virtual void _update(double p_delta) override;
 
 public:
-	void set_update_mode(UpdateMode p_mode) { update_mode = p_mode; }
+	void set_update_mode(UpdateMode p_mode);
 	UpdateMode get_update_mode() const { return update_mode; }
 
+	void set_batch_update(bool p_batch_update);
+	bool get_batch_update() const { return batch_update; }
+
 	void set_active(bool p_active);
 
 	void change_active_state(LimboState *p_state);
 
 	LimboState *get_active_state() const { return active_state; }
 	LimboState *get_previous_active_state() const { return previous_active; }
-	LimboState *get_leaf_state() const;
+	_FORCE_INLINE_ LimboState *get_leaf_state() const { return active_path.is_empty() ? const_cast<LimboHSM *>(this) : active_path[active_path.size() - 1]; }
+	_FORCE_INLINE_ const Vector<LimboState *> &get_active_path() const { return active_path; }
 
 	void set_initial_state(LimboState *p_state);
 	LimboState *get_initial_state() const { return initial_state; }
@@ -98,10 +190,24 @@ public:
 
 	void update(double p_delta);
 
+	PackedByteArray save_snapshot() const;
+	Error restore_snapshot(const PackedByteArray &p_snapshot);
+
+	void post_event(const StringName &p_event, const Variant &p_cargo = Variant());
+	void clear_event_queue();
+
+	void set_coalesce_events(bool p_coalesce) { coalesce_events = p_coalesce; }
+	bool get_coalesce_events() const { return coalesce_events; }
+
 	void add_transition(LimboState *p_from_state, LimboState *p_to_state, const StringName &p_event, const Callable &p_guard = Callable());
+	void add_native_transition(LimboState *p_from_state, LimboState *p_to_state, const StringName &p_event, LimboState::NativeGuardFunc p_guard, void *p_userdata = nullptr);
 	void remove_transition(LimboState *p_from_state, const StringName &p_event);
 	bool has_transition(LimboState *p_from_state, const StringName &p_event) const { return transitions.has(Transition::make_key(p_from_state, p_event)); }
 
+	void add_condition_transition(LimboState *p_from_state, LimboState *p_to_state, const Ref<LimboGuard> &p_guard);
+	void remove_condition_transition(LimboState *p_from_state, LimboState *p_to_state);
+	bool has_condition_transition(LimboState *p_from_state, LimboState *p_to_state) const;
+
 	LimboState *anystate() const { return nullptr; }
 
 	LimboHSM();
@@ -0,0 +1,129 @@
+/**
+ * limbo_hsm_scheduler.cpp
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "limbo_hsm_scheduler.h"
+
+#include "../compat/scene_tree.h"
+#include "../util/limbo_string_names.h"
+#include "limbo_hsm.h"
+
+#ifdef LIMBOAI_MODULE
+#include "scene/main/window.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/window.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+LimboHSMScheduler::RootList LimboHSMScheduler::idle_roots;
+LimboHSMScheduler::RootList LimboHSMScheduler::physics_roots;
+
+void LimboHSMScheduler::_compact(RootList &p_list) {
+	int j = 0;
+	LimboHSM **roots = p_list.roots.ptrw();
+	for (int i = 0; i < p_list.roots.size(); i++) {
+		if (roots[i] != nullptr) {
+			roots[j] = roots[i];
+			roots[j]->scheduler_index = j;
+			j++;
+		}
+	}
+	p_list.roots.resize(j);
+	p_list.has_removed = false;
+}
+
+void LimboHSMScheduler::_connect_to_tree(bool p_physics, bool p_connect) {
+	SceneTree *tree = SCENE_TREE();
+	ERR_FAIL_NULL(tree);
+	const StringName &signal = p_physics ? LW_NAME(physics_frame) : LW_NAME(process_frame);
+	Callable callable = p_physics ? callable_mp_static(&LimboHSMScheduler::_on_physics_frame) : callable_mp_static(&LimboHSMScheduler::_on_process_frame);
+	if (p_connect && !tree->is_connected(signal, callable)) {
+		tree->connect(signal, callable);
+	} else if (!p_connect && tree->is_connected(signal, callable)) {
+		tree->disconnect(signal, callable);
+	}
+}
+
+void LimboHSMScheduler::_on_process_frame() {
+	update(false, SCENE_TREE()->get_root()->get_process_delta_time());
+}
+
+void LimboHSMScheduler::_on_physics_frame() {
+	update(true, SCENE_TREE()->get_root()->get_physics_process_delta_time());
+}
+
+void LimboHSMScheduler::add_root(LimboHSM *p_hsm, bool p_physics) {
+	ERR_FAIL_NULL(p_hsm);
+	ERR_FAIL_COND(p_hsm->scheduler_index != -1);
+	RootList &list = _get_list(p_physics);
+	p_hsm->scheduler_index = list.roots.size();
+	list.roots.push_back(p_hsm);
+	list.count += 1;
+	if (list.count == 1) {
+		_connect_to_tree(p_physics, true);
+	}
+}
+
+void LimboHSMScheduler::remove_root(LimboHSM *p_hsm, bool p_physics) {
+	ERR_FAIL_NULL(p_hsm);
+	RootList &list = _get_list(p_physics);
+	int idx = p_hsm->scheduler_index;
+	ERR_FAIL_INDEX(idx, list.roots.size());
+	ERR_FAIL_COND(list.roots[idx] != p_hsm);
+
+	p_hsm->scheduler_index = -1;
+	if (list.updating) {
+		// Keep indices stable while iterating; compacted after the update loop.
+		list.roots.set(idx, nullptr);
+		list.has_removed = true;
+	} else {
+		// Swap-remove: the last HSM takes the freed slot.
+		int last = list.roots.size() - 1;
+		if (idx != last) {
+			LimboHSM *moved = list.roots[last];
+			list.roots.set(idx, moved);
+			moved->scheduler_index = idx;
+		}
+		list.roots.resize(last);
+	}
+
+	list.count -= 1;
+	if (list.count == 0) {
+		_connect_to_tree(p_physics, false);
+	}
+}
+
+void LimboHSMScheduler::update(bool p_physics, double p_delta) {
+	RootList &list = _get_list(p_physics);
+	ERR_FAIL_COND_MSG(list.updating, "LimboHSMScheduler: Recursive update is not allowed.");
+
+	list.updating = true;
+	// Evaluate guard conditions of all HSMs in one pass, before any of them is updated.
+	for (int i = 0; i < list.roots.size(); i++) {
+		LimboHSM *hsm = list.roots[i];
+		if (hsm != nullptr && hsm->active_state && !hsm->has_queued_events.is_set() && hsm->can_process()) {
+			hsm->_evaluate_conditions();
+		}
+	}
+	// Note: HSMs registered during the loop are appended and updated in the same frame.
+	// Each HSM checks its own pause state, so a paused HSM doesn't affect the others.
+	for (int i = 0; i < list.roots.size(); i++) {
+		LimboHSM *hsm = list.roots[i];
+		if (hsm != nullptr && hsm->is_initiating_update && hsm->can_process()) {
+			hsm->update(p_delta);
+		}
+	}
+	list.updating = false;
+
+	if (list.has_removed) {
+		_compact(list);
+	}
+}
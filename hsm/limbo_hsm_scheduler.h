@@ -0,0 +1,55 @@
+/**
+ * limbo_hsm_scheduler.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef LIMBO_HSM_SCHEDULER_H
+#define LIMBO_HSM_SCHEDULER_H
+
+#ifdef LIMBOAI_MODULE
+#include "core/templates/vector.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/templates/vector.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+class LimboHSM;
+
+// Updates batched root HSMs in a single loop, driven by the SceneTree's process_frame
+// and physics_frame signals, so no HSM node needs process notifications for it.
+// Each HSM stores its index in the list, which makes adding and removing O(1).
+class LimboHSMScheduler {
+private:
+	struct RootList {
+		Vector<LimboHSM *> roots;
+		int count = 0;
+		bool updating = false;
+		bool has_removed = false;
+	};
+
+	static RootList idle_roots;
+	static RootList physics_roots;
+
+	static _FORCE_INLINE_ RootList &_get_list(bool p_physics) { return p_physics ? physics_roots : idle_roots; }
+	static void _compact(RootList &p_list);
+	static void _connect_to_tree(bool p_physics, bool p_connect);
+	static void _on_process_frame();
+	static void _on_physics_frame();
+
+public:
+	static void add_root(LimboHSM *p_hsm, bool p_physics);
+	static void remove_root(LimboHSM *p_hsm, bool p_physics);
+	static int get_root_count(bool p_physics) { return _get_list(p_physics).count; }
+
+	static void update(bool p_physics, double p_delta);
+};
+
+#endif // LIMBO_HSM_SCHEDULER_H
@@ -11,12 +11,16 @@
 
 #include "limbo_state.h"
 
+#include "../compat/variant.h"
+
 #ifdef LIMBOAI_MODULE
 #include "core/config/engine.h"
+#include "core/templates/hash_set.h"
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
 #endif
 
 void LimboState::restart() {
@@ -61,12 +65,20 @@ Ref<BlackboardPlan> LimboState::_get_parent_scope_plan() const {
 	return parent_plan;
 }
 
-LimboState *LimboState::get_root() const {
-	const Node *state = this;
-	while (state->get_parent() && IS_CLASS(state->get_parent(), LimboState)) {
-		state = state->get_parent();
+void LimboState::_update_root_state(bool p_unparented) {
+	// Note: Parent is still assigned when NOTIFICATION_UNPARENTED is received.
+	LimboState *parent_state = p_unparented ? nullptr : Object::cast_to<LimboState>(get_parent());
+	LimboState *new_root = parent_state ? parent_state->root_state : this;
+	if (new_root == root_state) {
+		return;
+	}
+	root_state = new_root;
+	for (int i = 0; i < get_child_count(); i++) {
+		LimboState *c = Object::cast_to<LimboState>(get_child(i));
+		if (c) {
+			c->_update_root_state();
+		}
 	}
-	return const_cast<LimboState *>(Object::cast_to<LimboState>(state));
 }
 
 LimboState *LimboState::named(const String &p_name) {
@@ -78,10 +90,7 @@ void LimboState::_enter() {
 	active = true;
 	GDVIRTUAL_CALL(_enter);
 	emit_signal(LW_NAME(entered));
-	set_process(true);
-	set_physics_process(true);
-	set_process_input(true);
-	set_process_unhandled_input(true);
+	_update_node_processing();
 }
 
 void LimboState::_exit() {
@@ -90,11 +99,54 @@ void LimboState::_exit() {
 	}
 	GDVIRTUAL_CALL(_exit);
 	emit_signal(LW_NAME(exited));
-	set_process(false);
-	set_physics_process(false);
-	set_process_input(false);
-	set_process_unhandled_input(false);
 	active = false;
+	_update_node_processing();
+}
+
+void LimboState::_update_node_processing() {
+	set_process(active && (process_callbacks & PROCESS_CALLBACK_PROCESS));
+	set_physics_process(active && (process_callbacks & PROCESS_CALLBACK_PHYSICS_PROCESS));
+	set_process_input(active && (process_callbacks & PROCESS_CALLBACK_INPUT));
+	set_process_unhandled_input(active && (process_callbacks & PROCESS_CALLBACK_UNHANDLED_INPUT));
+}
+
+void LimboState::_save_snapshot(Array &r_data) const {
+	r_data.push_back(active);
+	if (_should_use_new_scope() && blackboard.is_valid()) {
+		r_data.push_back(blackboard->get_vars_as_dict());
+	} else {
+		// Blackboard is shared with the parent state.
+		r_data.push_back(Variant());
+	}
+}
+
+bool LimboState::_load_snapshot(const Array &p_data, int &r_pos) {
+	ERR_FAIL_COND_V_MSG(r_pos + 2 > p_data.size(), false, "LimboState: Snapshot data is truncated.");
+	active = p_data[r_pos];
+	if (p_data[r_pos + 1].get_type() == Variant::DICTIONARY && blackboard.is_valid()) {
+		Dictionary vars = p_data[r_pos + 1];
+		Array keys = vars.keys();
+		HashSet<StringName> saved_vars;
+		for (int i = 0; i < keys.size(); i++) {
+			saved_vars.insert(keys[i]);
+			blackboard->set_var(keys[i], VARIANT_RESOLVE_OBJECT_ID(vars[keys[i]]));
+		}
+		// Remove variables created after the snapshot was taken.
+		TypedArray<StringName> current_vars = blackboard->list_vars();
+		for (int i = 0; i < current_vars.size(); i++) {
+			if (!saved_vars.has(current_vars[i])) {
+				blackboard->erase_var(current_vars[i]);
+			}
+		}
+	}
+	r_pos += 2;
+	_update_node_processing();
+	return true;
+}
+
+void LimboState::set_process_callbacks(uint32_t p_callbacks) {
+	process_callbacks = p_callbacks;
+	_update_node_processing();
 }
 
 void LimboState::_update(double p_delta) {
@@ -124,50 +176,93 @@ void LimboState::_initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard)
 	_setup();
 }
 
+bool LimboState::_call_event_handler(const EventHandler &p_handler, const Variant &p_cargo) {
+	if (p_handler.native_func) {
+		return p_handler.native_func(this, p_cargo, p_handler.native_userdata);
+	}
+
+	Variant ret;
+
+#ifdef LIMBOAI_MODULE
+	Callable::CallError ce;
+	const Variant *argptrs[1] = { &p_cargo };
+	int argcount = p_cargo.get_type() == Variant::NIL ? 0 : 1;
+	p_handler.callable.callp(argptrs, argcount, ret, ce);
+	if (ce.error != Callable::CallError::CALL_OK) {
+		ERR_PRINT("Error calling event handler " + Variant::get_callable_error_text(p_handler.callable, argptrs, argcount, ce));
+	}
+#elif LIMBOAI_GDEXTENSION
+	if (p_cargo.get_type() == Variant::NIL) {
+		ret = p_handler.callable.call();
+	} else {
+		ret = p_handler.callable.call(p_cargo);
+	}
+#endif // LIMBOAI_GDEXTENSION
+
+	if (unlikely(ret.get_type() != Variant::BOOL)) {
+		ERR_PRINT("Event handler returned unexpected type: " + Variant::get_type_name(ret.get_type()));
+		return false;
+	}
+	return ret;
+}
+
 bool LimboState::_dispatch(const StringName &p_event, const Variant &p_cargo) {
 	ERR_FAIL_COND_V(p_event == StringName(), false);
-	if (handlers.size() > 0 && handlers.has(p_event)) {
-		Variant ret;
+	if (handlers.is_empty()) {
+		return false;
+	}
+	const EventHandler *handler = handlers.getptr(p_event);
+	if (handler == nullptr) {
+		return false;
+	}
+	return _call_event_handler(*handler, p_cargo);
+}
 
-#ifdef LIMBOAI_MODULE
-		Callable::CallError ce;
-		if (p_cargo.get_type() == Variant::NIL) {
-			handlers[p_event].callp(nullptr, 0, ret, ce);
-			if (ce.error != Callable::CallError::CALL_OK) {
-				ERR_PRINT("Error calling event handler " + Variant::get_callable_error_text(handlers[p_event], nullptr, 0, ce));
-			}
-		} else {
-			const Variant *argptrs[1];
-			argptrs[0] = &p_cargo;
-			handlers[p_event].callp(argptrs, 1, ret, ce);
-			if (ce.error != Callable::CallError::CALL_OK) {
-				ERR_PRINT("Error calling event handler " + Variant::get_callable_error_text(handlers[p_event], argptrs, 1, ce));
-			}
-		}
+bool LimboState::_is_entry_permitted() {
+	if (guard_condition.is_valid() && !guard_condition->is_satisfied(blackboard.ptr())) {
+		return false;
+	}
+	if (native_guard) {
+		return native_guard(this, native_guard_userdata);
+	}
+	if (!guard_callable.is_valid()) {
+		return true;
+	}
 
+	Variant ret;
+
+#ifdef LIMBOAI_MODULE
+	Callable::CallError ce;
+	guard_callable.callp(nullptr, 0, ret, ce);
+	if (unlikely(ce.error != Callable::CallError::CALL_OK)) {
+		ERR_PRINT_ONCE("LimboHSM: Error calling substate's guard callable: " + Variant::get_callable_error_text(guard_callable, nullptr, 0, ce));
+	}
 #elif LIMBOAI_GDEXTENSION
-		if (p_cargo.get_type() == Variant::NIL) {
-			ret = handlers[p_event].call();
-		} else {
-			Array args;
-			args.append(p_cargo);
-			ret = handlers[p_event].callv(args);
-		}
-#endif // LIMBOAI_GDEXTENSION
+	ret = guard_callable.call();
+#endif
 
-		if (unlikely(ret.get_type() != Variant::BOOL)) {
-			ERR_PRINT("Event handler returned unexpected type: " + Variant::get_type_name(ret.get_type()));
-		} else {
-			return ret;
-		}
+	if (unlikely(ret.get_type() != Variant::BOOL)) {
+		ERR_PRINT_ONCE(vformat("State guard callable %s returned non-boolean value (%s).", guard_callable, this));
+		return true;
 	}
-	return false;
+	return ret;
 }
 
 void LimboState::add_event_handler(const StringName &p_event, const Callable &p_handler) {
 	ERR_FAIL_COND(p_event == StringName());
 	ERR_FAIL_COND(!p_handler.is_valid());
-	handlers.insert(p_event, p_handler);
+	EventHandler handler;
+	handler.callable = p_handler;
+	handlers.insert(p_event, handler);
+}
+
+void LimboState::add_native_event_handler(const StringName &p_event, NativeEventHandlerFunc p_func, void *p_userdata) {
+	ERR_FAIL_COND(p_event == StringName());
+	ERR_FAIL_NULL(p_func);
+	EventHandler handler;
+	handler.native_func = p_func;
+	handler.native_userdata = p_userdata;
+	handlers.insert(p_event, handler);
 }
 
 bool LimboState::dispatch(const StringName &p_event, const Variant &p_cargo) {
@@ -195,23 +290,37 @@ LimboState *LimboState::call_on_update(const Callable &p_callable) {
 void LimboState::set_guard(const Callable &p_guard_callable) {
 	ERR_FAIL_COND(!p_guard_callable.is_valid());
 	guard_callable = p_guard_callable;
+	native_guard = nullptr;
+	native_guard_userdata = nullptr;
+}
+
+void LimboState::set_native_guard(NativeGuardFunc p_func, void *p_userdata) {
+	ERR_FAIL_NULL(p_func);
+	guard_callable = Callable();
+	native_guard = p_func;
+	native_guard_userdata = p_userdata;
 }
 
 void LimboState::clear_guard() {
 	guard_callable = Callable();
+	native_guard = nullptr;
+	native_guard_userdata = nullptr;
 }
 
 void LimboState::_notification(int p_what) {
 	switch (p_what) {
+		case NOTIFICATION_PARENTED: {
+			_update_root_state();
+		} break;
+		case NOTIFICATION_UNPARENTED: {
+			_update_root_state(true);
+		} break;
 		case NOTIFICATION_READY: {
 			if (Engine::get_singleton()->is_editor_hint()) {
 				_update_blackboard_plan();
 			}
 
-			set_process(active);
-			set_physics_process(active);
-			set_process_input(active);
-			set_process_unhandled_input(active);
+			_update_node_processing();
 		} break;
 	}
 }
@@ -232,11 +341,16 @@ void LimboState::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("call_on_update", "callable"), &LimboState::call_on_update);
 	ClassDB::bind_method(D_METHOD("set_guard", "guard_callable"), &LimboState::set_guard);
 	ClassDB::bind_method(D_METHOD("clear_guard"), &LimboState::clear_guard);
+	ClassDB::bind_method(D_METHOD("set_guard_condition", "guard_condition"), &LimboState::set_guard_condition);
+	ClassDB::bind_method(D_METHOD("get_guard_condition"), &LimboState::get_guard_condition);
 	ClassDB::bind_method(D_METHOD("get_blackboard"), &LimboState::get_blackboard);
 
 	ClassDB::bind_method(D_METHOD("set_blackboard_plan", "plan"), &LimboState::set_blackboard_plan);
 	ClassDB::bind_method(D_METHOD("get_blackboard_plan"), &LimboState::get_blackboard_plan);
 
+	ClassDB::bind_method(D_METHOD("set_process_callbacks", "callbacks"), &LimboState::set_process_callbacks);
+	ClassDB::bind_method(D_METHOD("get_process_callbacks"), &LimboState::get_process_callbacks);
+
 	ClassDB::bind_method(D_METHOD("_get_parent_scope_plan"), &LimboState::_get_parent_scope_plan);
 
 	GDVIRTUAL_BIND(_setup);
@@ -248,6 +362,13 @@ void LimboState::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "agent", PROPERTY_HINT_RESOURCE_TYPE, "Node", 0), "set_agent", "get_agent");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "blackboard", PROPERTY_HINT_RESOURCE_TYPE, "Blackboard", 0), "", "get_blackboard");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "blackboard_plan", PROPERTY_HINT_RESOURCE_TYPE, "BlackboardPlan", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_ALWAYS_DUPLICATE), "set_blackboard_plan", "get_blackboard_plan");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "guard_condition", PROPERTY_HINT_RESOURCE_TYPE, "LimboGuard"), "set_guard_condition", "get_guard_condition");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_callbacks", PROPERTY_HINT_FLAGS, "Process,Physics Process,Input,Unhandled Input"), "set_process_callbacks", "get_process_callbacks");
+
+	BIND_ENUM_CONSTANT(PROCESS_CALLBACK_PROCESS);
+	BIND_ENUM_CONSTANT(PROCESS_CALLBACK_PHYSICS_PROCESS);
+	BIND_ENUM_CONSTANT(PROCESS_CALLBACK_INPUT);
+	BIND_ENUM_CONSTANT(PROCESS_CALLBACK_UNHANDLED_INPUT);
 
 	ADD_SIGNAL(MethodInfo("setup"));
 	ADD_SIGNAL(MethodInfo("entered"));
@@ -257,6 +378,7 @@ void LimboState::_bind_methods() {
 
 LimboState::LimboState() {
 	EVENT_FINISHED = StringName("finished_" + itos(get_instance_id()));
+	root_state = this;
 	agent = nullptr;
 	active = false;
 	blackboard = Ref<Blackboard>(memnew(Blackboard));
@@ -14,6 +14,7 @@
 
 #include "../blackboard/blackboard.h"
 #include "../blackboard/blackboard_plan.h"
+#include "limbo_guard.h"
 
 #include "../compat/object.h"
 #include "../util/limbo_string_names.h"
@@ -33,16 +34,43 @@ class LimboHSM;
 class LimboState : public Node {
 	GDCLASS(LimboState, Node);
 
+public:
+	enum ProcessCallback : unsigned int {
+		PROCESS_CALLBACK_PROCESS = 1,
+		PROCESS_CALLBACK_PHYSICS_PROCESS = 2,
+		PROCESS_CALLBACK_INPUT = 4,
+		PROCESS_CALLBACK_UNHANDLED_INPUT = 8,
+	};
+
+	// Native callbacks for C++ code: invoked directly, without Variant boxing.
+	typedef bool (*NativeGuardFunc)(LimboState *p_state, void *p_userdata);
+	typedef bool (*NativeEventHandlerFunc)(LimboState *p_state, const Variant &p_cargo, void *p_userdata);
+
 private:
+	struct EventHandler {
+		Callable callable;
+		NativeEventHandlerFunc native_func = nullptr;
+		void *native_userdata = nullptr;
+	};
+
 	StringName EVENT_FINISHED;
 	bool active;
 	Ref<BlackboardPlan> blackboard_plan;
 	Node *agent;
 	Ref<Blackboard> blackboard;
-	HashMap<StringName, Callable> handlers;
+	HashMap<StringName, EventHandler> handlers;
 	Callable guard_callable;
+	NativeGuardFunc native_guard = nullptr;
+	void *native_guard_userdata = nullptr;
+	Ref<LimboGuard> guard_condition;
+	int transition_row = -1; // Row in the parent HSM's compiled transition table.
+	LimboState *root_state = nullptr; // Cached; updated when the state is reparented.
+	uint32_t process_callbacks = PROCESS_CALLBACK_PROCESS | PROCESS_CALLBACK_PHYSICS_PROCESS | PROCESS_CALLBACK_INPUT | PROCESS_CALLBACK_UNHANDLED_INPUT;
 
 	Ref<BlackboardPlan> _get_parent_scope_plan() const;
+	bool _call_event_handler(const EventHandler &p_handler, const Variant &p_cargo);
+	bool _is_entry_permitted();
+	void _update_root_state(bool p_unparented = false);
 
 protected:
 	friend LimboHSM;
@@ -56,6 +84,10 @@ protected:
 
 	virtual bool _should_use_new_scope() const { return blackboard_plan.is_valid() || is_root(); }
 	virtual void _update_blackboard_plan();
+	virtual void _update_node_processing();
+
+	virtual void _save_snapshot(Array &r_data) const;
+	virtual bool _load_snapshot(const Array &p_data, int &r_pos);
 	virtual Node *_get_prefetch_root_for_base_plan();
 
 	virtual void _setup();
@@ -89,17 +121,27 @@ public:
 	LimboState *call_on_update(const Callable &p_callable);
 
 	void add_event_handler(const StringName &p_event, const Callable &p_handler);
+	void add_native_event_handler(const StringName &p_event, NativeEventHandlerFunc p_func, void *p_userdata = nullptr);
 	bool dispatch(const StringName &p_event, const Variant &p_cargo = Variant());
 
 	_FORCE_INLINE_ StringName event_finished() const { return EVENT_FINISHED; }
-	LimboState *get_root() const;
-	_FORCE_INLINE_ bool is_root() const { return !(get_parent() && IS_CLASS(get_parent(), LimboState)); }
+	_FORCE_INLINE_ LimboState *get_root() const { return root_state; }
+	_FORCE_INLINE_ bool is_root() const { return root_state == this; }
 	_FORCE_INLINE_ bool is_active() const { return active; }
 
+	void set_process_callbacks(uint32_t p_callbacks);
+	uint32_t get_process_callbacks() const { return process_callbacks; }
+
 	void set_guard(const Callable &p_guard_callable);
+	void set_native_guard(NativeGuardFunc p_func, void *p_userdata = nullptr);
 	void clear_guard();
 
+	void set_guard_condition(const Ref<LimboGuard> &p_guard_condition) { guard_condition = p_guard_condition; }
+	Ref<LimboGuard> get_guard_condition() const { return guard_condition; }
+
 	LimboState();
 };
 
+VARIANT_ENUM_CAST(LimboState::ProcessCallback);
+
 #endif // LIMBO_STATE_H
@@ -49,6 +49,7 @@
 #include "blackboard/blackboard.h"
 #include "blackboard/blackboard_plan.h"
 #include "bt/behavior_tree.h"
+#include "bt/behavior_tree_generator.h"
 #include "bt/bt_player.h"
 #include "bt/bt_state.h"
 #include "bt/tasks/blackboard/bt_check_trigger.h"
@@ -104,8 +105,11 @@
 #include "editor/editor_property_variable_name.h"
 #include "editor/mode_switch_button.h"
 #include "editor/tree_search.h"
+#include "hsm/limbo_guard.h"
 #include "hsm/limbo_hsm.h"
 #include "hsm/limbo_state.h"
+#include "util/limbo_metrics.h"
+#include "util/limbo_profiler.h"
 #include "util/limbo_string_names.h"
 #include "util/limbo_task_db.h"
 #include "util/limbo_utility.h"
@@ -129,6 +133,8 @@ using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
 
 static LimboUtility *_limbo_utility = nullptr;
+static LimboMetrics *_limbo_metrics = nullptr;
+static LimboProfiler *_limbo_profiler = nullptr;
 
 void initialize_limboai_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SCENE) {
@@ -142,15 +148,19 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 		LimboDebugger::initialize();
 
 		GDREGISTER_CLASS(LimboUtility);
+		GDREGISTER_CLASS(LimboMetrics);
+		GDREGISTER_CLASS(LimboProfiler);
 		GDREGISTER_CLASS(Blackboard);
 		GDREGISTER_CLASS(BlackboardPlan);
 
+		GDREGISTER_CLASS(LimboGuard);
 		GDREGISTER_CLASS(LimboState);
 		GDREGISTER_CLASS(LimboHSM);
 
 		GDREGISTER_ABSTRACT_CLASS(BT);
 		GDREGISTER_ABSTRACT_CLASS(BTTask);
 		GDREGISTER_CLASS(BehaviorTree);
+		GDREGISTER_CLASS(BehaviorTreeGenerator);
 		GDREGISTER_CLASS(BTInstance);
 		GDREGISTER_CLASS(BTPlayer);
 		GDREGISTER_CLASS(BTState);
@@ -239,11 +249,17 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 		GDREGISTER_CLASS(BBVector4i);
 
 		_limbo_utility = memnew(LimboUtility);
+		_limbo_metrics = memnew(LimboMetrics);
+		_limbo_profiler = memnew(LimboProfiler);
 
 #ifdef LIMBOAI_MODULE
 		Engine::get_singleton()->add_singleton(Engine::Singleton("LimboUtility", LimboUtility::get_singleton()));
+		Engine::get_singleton()->add_singleton(Engine::Singleton("LimboMetrics", LimboMetrics::get_singleton()));
+		Engine::get_singleton()->add_singleton(Engine::Singleton("LimboProfiler", LimboProfiler::get_singleton()));
 #elif LIMBOAI_GDEXTENSION
 		Engine::get_singleton()->register_singleton("LimboUtility", LimboUtility::get_singleton());
+		Engine::get_singleton()->register_singleton("LimboMetrics", LimboMetrics::get_singleton());
+		Engine::get_singleton()->register_singleton("LimboProfiler", LimboProfiler::get_singleton());
 #endif
 
 		LimboStringNames::create();
@@ -289,6 +305,8 @@ void uninitialize_limboai_module(ModuleInitializationLevel p_level) {
 		LimboDebugger::deinitialize();
 		LimboStringNames::free();
 		memdelete(_limbo_utility);
+		memdelete(_limbo_metrics);
+		memdelete(_limbo_profiler);
 	}
 }
 
@@ -0,0 +1,77 @@
+/**
+ * alloc_tracker.cpp
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "alloc_tracker.h"
+
+#ifdef LIMBOAI_TRACK_ALLOCATIONS
+
+#include <cstddef>
+
+static thread_local bool tracking = false;
+static thread_local uint64_t num_allocations = 0;
+
+extern "C" {
+
+void *__real_malloc(size_t p_size);
+void *__real_calloc(size_t p_count, size_t p_size);
+void *__real_realloc(void *p_ptr, size_t p_size);
+
+void *__wrap_malloc(size_t p_size) {
+	if (tracking) {
+		num_allocations++;
+	}
+	return __real_malloc(p_size);
+}
+
+void *__wrap_calloc(size_t p_count, size_t p_size) {
+	if (tracking) {
+		num_allocations++;
+	}
+	return __real_calloc(p_count, p_size);
+}
+
+void *__wrap_realloc(void *p_ptr, size_t p_size) {
+	if (tracking) {
+		num_allocations++;
+	}
+	return __real_realloc(p_ptr, p_size);
+}
+
+} // extern "C"
+
+bool LimboAllocTracker::is_available() {
+	return true;
+}
+
+void LimboAllocTracker::start() {
+	num_allocations = 0;
+	tracking = true;
+}
+
+uint64_t LimboAllocTracker::stop() {
+	tracking = false;
+	return num_allocations;
+}
+
+#else
+
+bool LimboAllocTracker::is_available() {
+	return false;
+}
+
+void LimboAllocTracker::start() {
+}
+
+uint64_t LimboAllocTracker::stop() {
+	return 0;
+}
+
+#endif // LIMBOAI_TRACK_ALLOCATIONS
@@ -0,0 +1,27 @@
+/**
+ * alloc_tracker.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <cstdint>
+
+// Counts heap allocations made by the current thread between start() and stop().
+// Only available in Linux test builds with limboai_track_allocations=yes, where malloc, calloc
+// and realloc are wrapped at link time (see SCsub). This covers memalloc/memnew, which go through malloc.
+class LimboAllocTracker {
+public:
+	static bool is_available();
+	static void start();
+	static uint64_t stop();
+};
+
+#endif // ALLOC_TRACKER_H
@@ -0,0 +1,159 @@
+/**
+ * test_allocations.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_ALLOCATIONS_H
+#define TEST_ALLOCATIONS_H
+
+#include "alloc_tracker.h"
+#include "limbo_test.h"
+
+#include "modules/limboai/blackboard/bb_param/bb_node.h"
+#include "modules/limboai/blackboard/bb_param/bb_variant.h"
+#include "modules/limboai/blackboard/blackboard.h"
+#include "modules/limboai/bt/bt_instance.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_check_var.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_set_var.h"
+#include "modules/limboai/bt/tasks/composites/bt_dynamic_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_dynamic_sequence.h"
+#include "modules/limboai/bt/tasks/composites/bt_parallel.h"
+#include "modules/limboai/bt/tasks/composites/bt_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+#include "modules/limboai/bt/tasks/decorators/bt_always_fail.h"
+#include "modules/limboai/bt/tasks/decorators/bt_always_succeed.h"
+#include "modules/limboai/bt/tasks/decorators/bt_invert.h"
+#include "modules/limboai/bt/tasks/decorators/bt_repeat.h"
+#include "modules/limboai/bt/tasks/decorators/bt_repeat_until_success.h"
+#include "modules/limboai/bt/tasks/decorators/bt_time_limit.h"
+#include "modules/limboai/bt/tasks/utility/bt_call_method.h"
+#include "modules/limboai/bt/tasks/utility/bt_wait_ticks.h"
+
+namespace TestAllocations {
+
+const int WARMUP_TICKS = 10;
+const int MEASURED_TICKS = 100;
+
+// Returns the number of heap allocations made during MEASURED_TICKS updates of a warmed-up instance.
+// The tree is used without cloning, so that BTTestAction tasks keep their return status.
+inline uint64_t count_update_allocations(const Ref<BTTask> &p_root, const Ref<Blackboard> &p_blackboard, Node *p_agent) {
+	p_root->initialize(p_agent, p_blackboard, p_agent);
+	Ref<BTInstance> inst = BTInstance::create(p_root, "", p_agent);
+	for (int i = 0; i < WARMUP_TICKS; i++) {
+		inst->update(0.1);
+	}
+	LimboAllocTracker::start();
+	for (int i = 0; i < MEASURED_TICKS; i++) {
+		inst->update(0.1);
+	}
+	return LimboAllocTracker::stop();
+}
+
+inline Ref<BTTask> make_composite(BTTask *p_composite, BTTask::Status p_child_status) {
+	Ref<BTTask> composite = p_composite;
+	for (int i = 0; i < 3; i++) {
+		composite->add_child(memnew(BTTestAction(p_child_status)));
+	}
+	return composite;
+}
+
+inline Ref<BTTask> make_decorator(BTTask *p_decorator, BTTask::Status p_child_status) {
+	Ref<BTTask> decorator = p_decorator;
+	decorator->add_child(memnew(BTTestAction(p_child_status)));
+	return decorator;
+}
+
+inline Ref<BBVariant> make_int_param(int p_value) {
+	Ref<BBVariant> param = memnew(BBVariant);
+	param->set_saved_value(p_value);
+	return param;
+}
+
+#define CHECK_NO_ALLOCATIONS(m_name, m_root)                                    \
+	{                                                                           \
+		uint64_t num_allocations = count_update_allocations(m_root, bb, dummy); \
+		INFO(m_name, ": ", num_allocations, " allocations");                    \
+		CHECK(num_allocations == 0);                                            \
+	}
+
+TEST_CASE("[Modules][LimboAI] Zero allocations per tick") {
+	if (!LimboAllocTracker::is_available()) {
+		MESSAGE("Allocation tracking is not available in this build, skipping.");
+		return;
+	}
+
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	bb->set_var("speed", 1);
+	Ref<CallbackCounter> callback_counter = memnew(CallbackCounter);
+	bb->set_var("object", callback_counter);
+
+	SUBCASE("Composites") {
+		CHECK_NO_ALLOCATIONS("BTSequence", make_composite(memnew(BTSequence), BTTask::SUCCESS));
+		CHECK_NO_ALLOCATIONS("BTSequence (running)", make_composite(memnew(BTSequence), BTTask::RUNNING));
+		CHECK_NO_ALLOCATIONS("BTSelector", make_composite(memnew(BTSelector), BTTask::FAILURE));
+		CHECK_NO_ALLOCATIONS("BTParallel", make_composite(memnew(BTParallel), BTTask::SUCCESS));
+		CHECK_NO_ALLOCATIONS("BTDynamicSequence", make_composite(memnew(BTDynamicSequence), BTTask::RUNNING));
+		CHECK_NO_ALLOCATIONS("BTDynamicSelector", make_composite(memnew(BTDynamicSelector), BTTask::FAILURE));
+	}
+
+	SUBCASE("Decorators") {
+		CHECK_NO_ALLOCATIONS("BTInvert", make_decorator(memnew(BTInvert), BTTask::SUCCESS));
+		CHECK_NO_ALLOCATIONS("BTAlwaysSucceed", make_decorator(memnew(BTAlwaysSucceed), BTTask::FAILURE));
+		CHECK_NO_ALLOCATIONS("BTAlwaysFail", make_decorator(memnew(BTAlwaysFail), BTTask::SUCCESS));
+		CHECK_NO_ALLOCATIONS("BTRepeatUntilSuccess", make_decorator(memnew(BTRepeatUntilSuccess), BTTask::FAILURE));
+		CHECK_NO_ALLOCATIONS("BTTimeLimit", make_decorator(memnew(BTTimeLimit), BTTask::RUNNING));
+
+		Ref<BTRepeat> repeat = memnew(BTRepeat);
+		repeat->set_times(3);
+		CHECK_NO_ALLOCATIONS("BTRepeat", make_decorator(repeat.ptr(), BTTask::SUCCESS));
+	}
+
+	SUBCASE("Actions and conditions") {
+		Ref<BTWaitTicks> wait_ticks = memnew(BTWaitTicks);
+		wait_ticks->set_num_ticks(5);
+		CHECK_NO_ALLOCATIONS("BTWaitTicks", wait_ticks);
+
+		Ref<BTCheckVar> check_var = memnew(BTCheckVar);
+		check_var->set_variable("speed");
+		check_var->set_value(make_int_param(1));
+		CHECK_NO_ALLOCATIONS("BTCheckVar", check_var);
+
+		Ref<BTSetVar> set_var = memnew(BTSetVar);
+		set_var->set_variable("speed");
+		set_var->set_value(make_int_param(2));
+		CHECK_NO_ALLOCATIONS("BTSetVar", set_var);
+
+		Ref<BBNode> node_param = memnew(BBNode);
+		node_param->set_value_source(BBParam::BLACKBOARD_VAR);
+		node_param->set_variable("object");
+		Ref<BTCallMethod> call_method = memnew(BTCallMethod);
+		call_method->set_node_param(node_param);
+		call_method->set_method("callback_delta");
+		call_method->set_include_delta(true);
+		CHECK_NO_ALLOCATIONS("BTCallMethod", call_method);
+
+		// Argument values are constructed on the stack.
+		Ref<BTCallMethod> call_method_args = memnew(BTCallMethod);
+		call_method_args->set_node_param(node_param);
+		call_method_args->set_method("callback_delta");
+		TypedArray<BBVariant> args;
+		args.push_back(memnew(BBVariant(0.5)));
+		call_method_args->set_args(args);
+		CHECK_NO_ALLOCATIONS("BTCallMethod (with arguments)", call_method_args);
+	}
+
+	memdelete(dummy);
+}
+
+#undef CHECK_NO_ALLOCATIONS
+
+} //namespace TestAllocations
+
+#endif // TEST_ALLOCATIONS_H
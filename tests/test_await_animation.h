@@ -84,6 +84,37 @@ TEST_CASE("[SceneTree][LimboAI] BTAwaitAnimation") {
 			}
 		}
 	}
+	SUBCASE("When using signals") {
+		awa->set_use_signals(true);
+		player_param->set_saved_value(player->get_path());
+		awa->initialize(dummy, bb, dummy);
+
+		SUBCASE("When AnimationPlayer is not playing") {
+			REQUIRE_FALSE(player->is_playing());
+			CHECK(awa->execute(0.01666) == BTTask::SUCCESS);
+		}
+		SUBCASE("When animation finishes playing") {
+			player->play("test");
+			CHECK(awa->execute(0.01666) == BTTask::RUNNING);
+			CHECK(awa->execute(0.01666) == BTTask::RUNNING);
+			// Emitting directly, as the engine may defer this signal.
+			player->emit_signal(SNAME("animation_finished"), StringName("test"));
+			CHECK(awa->execute(0.01666) == BTTask::SUCCESS);
+		}
+		SUBCASE("When another animation is played") {
+			player->play("test");
+			CHECK(awa->execute(0.01666) == BTTask::RUNNING);
+			player->emit_signal(SNAME("current_animation_changed"), String("other"));
+			CHECK(awa->execute(0.01666) == BTTask::SUCCESS);
+		}
+		SUBCASE("When AnimationPlayer is stopped") {
+			player->play("test");
+			CHECK(awa->execute(0.01666) == BTTask::RUNNING);
+			// stop() doesn't emit any of the tracked signals.
+			player->stop();
+			CHECK(awa->execute(0.01666) == BTTask::SUCCESS);
+		}
+	}
 
 	memdelete(dummy);
 	memdelete(player);
@@ -0,0 +1,73 @@
+/**
+ * test_behavior_tree_generator.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BEHAVIOR_TREE_GENERATOR_H
+#define TEST_BEHAVIOR_TREE_GENERATOR_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/behavior_tree_generator.h"
+
+namespace TestBehaviorTreeGenerator {
+
+inline void collect_classes(const Ref<BTTask> &p_task, PackedStringArray &r_classes) {
+	r_classes.push_back(p_task->get_class());
+	for (int i = 0; i < p_task->get_child_count(); i++) {
+		collect_classes(p_task->get_child(i), r_classes);
+	}
+}
+
+TEST_CASE("[Modules][LimboAI] BehaviorTreeGenerator") {
+	Ref<BehaviorTreeGenerator> generator = memnew(BehaviorTreeGenerator);
+	generator->set_seed(42);
+	generator->set_max_depth(3);
+	generator->set_branching_factor(3);
+
+	SUBCASE("Same seed produces the same tree") {
+		PackedStringArray first;
+		PackedStringArray second;
+		collect_classes(generator->generate()->get_root_task(), first);
+		collect_classes(generator->generate()->get_root_task(), second);
+		CHECK(first.size() > 1);
+		CHECK(first == second);
+	}
+
+	SUBCASE("Tree size follows depth and branching factor") {
+		generator->set_composite_weight(1.0);
+		generator->set_decorator_weight(0.0);
+		generator->set_action_weight(0.0);
+		generator->set_condition_weight(0.0);
+		// Only composites above the max depth, so the tree is complete: 1 + 3 + 9 + 27.
+		Ref<BehaviorTree> bt = generator->generate();
+		CHECK(BehaviorTreeGenerator::get_task_count(bt->get_root_task()) == 40);
+	}
+
+	SUBCASE("Generated tree can be instantiated and ticked") {
+		generator->set_subtree_count(2);
+		generator->set_subtree_chance(0.5);
+		Ref<BehaviorTree> bt = generator->generate();
+		REQUIRE(bt->get_blackboard_plan().is_valid());
+		CHECK(bt->get_blackboard_plan()->get_var_count() == generator->get_blackboard_size());
+
+		Node *dummy = memnew(Node);
+		Ref<BTInstance> inst = bt->instantiate(dummy, bt->get_blackboard_plan()->create_blackboard(dummy), dummy, dummy);
+		REQUIRE(inst.is_valid());
+		for (int i = 0; i < 10; i++) {
+			inst->update(0.1);
+		}
+		CHECK(inst->get_last_status() != BTTask::FRESH);
+		memdelete(dummy);
+	}
+}
+
+} //namespace TestBehaviorTreeGenerator
+
+#endif // TEST_BEHAVIOR_TREE_GENERATOR_H
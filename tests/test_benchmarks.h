@@ -0,0 +1,266 @@
+/**
+ * test_benchmarks.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BENCHMARKS_H
+#define TEST_BENCHMARKS_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/behavior_tree_generator.h"
+#include "modules/limboai/bt/bt_instance.h"
+#include "modules/limboai/bt/tasks/composites/bt_dynamic_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_dynamic_sequence.h"
+#include "modules/limboai/bt/tasks/composites/bt_parallel.h"
+#include "modules/limboai/bt/tasks/composites/bt_probability_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_random_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_random_sequence.h"
+#include "modules/limboai/bt/tasks/composites/bt_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+#include "modules/limboai/bt/tasks/decorators/bt_always_fail.h"
+#include "modules/limboai/bt/tasks/decorators/bt_always_succeed.h"
+#include "modules/limboai/bt/tasks/decorators/bt_invert.h"
+#include "modules/limboai/bt/tasks/decorators/bt_new_scope.h"
+#include "modules/limboai/bt/tasks/decorators/bt_probability.h"
+#include "modules/limboai/bt/tasks/decorators/bt_repeat.h"
+#include "modules/limboai/bt/tasks/decorators/bt_repeat_until_failure.h"
+#include "modules/limboai/bt/tasks/decorators/bt_repeat_until_success.h"
+#include "modules/limboai/bt/tasks/decorators/bt_time_limit.h"
+#include "modules/limboai/bt/tasks/utility/bt_fail.h"
+
+#include "core/config/engine.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/os.h"
+
+// Micro-benchmarks are skipped during regular test runs. To run them headless:
+//   godot --headless --test --test-case="*[Benchmark]*" --no-skip
+// Set LIMBOAI_BENCHMARK_OUTPUT to a file path to store the results as JSON,
+// and LIMBOAI_BENCHMARK_ITERATIONS to change the number of iterations (default: 100000).
+
+namespace TestBenchmarks {
+
+class BenchmarkReport {
+private:
+	Array results;
+	int iterations = 100000;
+
+public:
+	int get_iterations() const { return iterations; }
+
+	template <typename F>
+	void measure(const String &p_group, const String &p_name, int p_iterations, F p_fn, const Dictionary &p_params = Dictionary()) {
+		// Warm up caches and lazily initialized state.
+		for (int i = 0; i < MAX(1, p_iterations / 10); i++) {
+			p_fn();
+		}
+		uint64_t start = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < p_iterations; i++) {
+			p_fn();
+		}
+		uint64_t end = OS::get_singleton()->get_ticks_usec();
+		double ns_per_op = double(end - start) * 1000.0 / double(p_iterations);
+
+		Dictionary result;
+		result["group"] = p_group;
+		result["name"] = p_name;
+		result["iterations"] = p_iterations;
+		result["ns_per_op"] = ns_per_op;
+		result["params"] = p_params;
+		results.push_back(result);
+		MESSAGE(vformat("%s/%s: %.1f ns", p_group, p_name, ns_per_op));
+	}
+
+	void write() const {
+		Dictionary report;
+		report["engine_version"] = Engine::get_singleton()->get_version_info()["string"];
+		report["build"] = OS::get_singleton()->is_debug_build() ? "debug" : "release";
+		report["results"] = results;
+		String json = JSON::stringify(report, "\t");
+
+		String path = OS::get_singleton()->get_environment("LIMBOAI_BENCHMARK_OUTPUT");
+		if (path.is_empty()) {
+			print_line(json);
+			return;
+		}
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE_MESSAGE(f.is_valid(), "Failed to open benchmark output file: " + path);
+		f->store_string(json);
+	}
+
+	BenchmarkReport() {
+		String iterations_env = OS::get_singleton()->get_environment("LIMBOAI_BENCHMARK_ITERATIONS");
+		if (iterations_env.is_valid_int()) {
+			iterations = MAX(1, iterations_env.to_int());
+		}
+	}
+};
+
+inline Ref<BTTask> make_balanced_tree(int p_num_tasks, int p_branching) {
+	// Breadth-first fill, so that the tree is as shallow as possible.
+	Vector<Ref<BTTask>> nodes;
+	Ref<BTSequence> root = memnew(BTSequence);
+	nodes.push_back(root);
+	int parent_idx = 0;
+	while (nodes.size() < p_num_tasks) {
+		Ref<BTTask> parent = nodes[parent_idx];
+		if (parent->get_child_count() >= p_branching) {
+			parent_idx += 1;
+			continue;
+		}
+		bool is_leaf_level = nodes.size() + p_branching > p_num_tasks;
+		Ref<BTTask> child = is_leaf_level ? Ref<BTTask>(memnew(BTFail)) : Ref<BTTask>(memnew(BTSequence));
+		parent->add_child(child);
+		nodes.push_back(child);
+	}
+	return root;
+}
+
+TEST_CASE("[Benchmark][LimboAI] Core task micro-benchmarks" * doctest::skip()) {
+	BenchmarkReport report;
+	const int iterations = report.get_iterations();
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+
+	// * BTTask::execute overhead on a single leaf.
+	{
+		Ref<BTTestAction> leaf = memnew(BTTestAction(BTTask::SUCCESS));
+		leaf->initialize(dummy, bb, dummy);
+		report.measure("execute", "leaf_success", iterations, [&]() { leaf->execute(0.01); });
+		leaf->ret_status = BTTask::RUNNING;
+		report.measure("execute", "leaf_running", iterations, [&]() { leaf->execute(0.01); });
+	}
+
+	// * Composites with three children, chosen so that every child is ticked.
+	{
+		struct CompositeCase {
+			const char *name;
+			Ref<BTTask> task;
+			BTTask::Status child_status;
+		};
+		CompositeCase cases[] = {
+			{ "BTSequence", memnew(BTSequence), BTTask::SUCCESS },
+			{ "BTSelector", memnew(BTSelector), BTTask::FAILURE },
+			{ "BTParallel", memnew(BTParallel), BTTask::SUCCESS },
+			{ "BTDynamicSequence", memnew(BTDynamicSequence), BTTask::SUCCESS },
+			{ "BTDynamicSelector", memnew(BTDynamicSelector), BTTask::FAILURE },
+			{ "BTRandomSequence", memnew(BTRandomSequence), BTTask::SUCCESS },
+			{ "BTRandomSelector", memnew(BTRandomSelector), BTTask::FAILURE },
+			{ "BTProbabilitySelector", memnew(BTProbabilitySelector), BTTask::FAILURE },
+		};
+		for (CompositeCase &c : cases) {
+			for (int i = 0; i < 3; i++) {
+				c.task->add_child(memnew(BTTestAction(c.child_status)));
+			}
+			c.task->initialize(dummy, bb, dummy);
+			report.measure("composite", c.name, iterations, [&]() { c.task->execute(0.01); });
+		}
+	}
+
+	// * Decorators over a single leaf. Tree-dependent decorators (cooldown, delay) are not included.
+	{
+		Ref<BTRepeat> repeat = memnew(BTRepeat);
+		repeat->set_times(3);
+		Ref<BTProbability> probability = memnew(BTProbability);
+		probability->set_run_chance(1.0);
+		Ref<BTTimeLimit> time_limit = memnew(BTTimeLimit);
+		time_limit->set_time_limit(1.0e9);
+
+		struct DecoratorCase {
+			const char *name;
+			Ref<BTTask> task;
+			BTTask::Status child_status;
+		};
+		DecoratorCase cases[] = {
+			{ "BTInvert", memnew(BTInvert), BTTask::SUCCESS },
+			{ "BTAlwaysSucceed", memnew(BTAlwaysSucceed), BTTask::FAILURE },
+			{ "BTAlwaysFail", memnew(BTAlwaysFail), BTTask::SUCCESS },
+			{ "BTRepeat", repeat, BTTask::SUCCESS },
+			{ "BTRepeatUntilSuccess", memnew(BTRepeatUntilSuccess), BTTask::SUCCESS },
+			{ "BTRepeatUntilFailure", memnew(BTRepeatUntilFailure), BTTask::FAILURE },
+			{ "BTProbability", probability, BTTask::SUCCESS },
+			{ "BTTimeLimit", time_limit, BTTask::SUCCESS },
+			{ "BTNewScope", memnew(BTNewScope), BTTask::SUCCESS },
+		};
+		for (DecoratorCase &c : cases) {
+			c.task->add_child(memnew(BTTestAction(c.child_status)));
+			c.task->initialize(dummy, bb, dummy);
+			report.measure("decorator", c.name, iterations, [&]() { c.task->execute(0.01); });
+		}
+	}
+
+	// * Cloning and instantiation cost by tree size. Keys are stable across releases for regression tracking.
+	{
+		const int sizes[] = { 10, 100, 1000 };
+		for (int size : sizes) {
+			Ref<BehaviorTree> bt = memnew(BehaviorTree);
+			bt->set_root_task(make_balanced_tree(size, 4));
+			Dictionary params;
+			params["tasks"] = size;
+			int n = MAX(10, iterations / size);
+
+			report.measure("tree", vformat("clone_%d", size), n, [&]() { bt->get_root_task()->clone(); }, params);
+			report.measure("tree", vformat("instantiate_%d", size), n, [&]() { bt->instantiate(dummy, memnew(Blackboard), dummy, dummy); }, params);
+		}
+	}
+
+	// * Cloning, instantiation and tick cost of generated trees with a realistic task mix.
+	{
+		Ref<BehaviorTreeGenerator> generator = memnew(BehaviorTreeGenerator);
+		generator->set_seed(1);
+		generator->set_branching_factor(4);
+		const int depths[] = { 1, 2, 3, 4 };
+		for (int depth : depths) {
+			generator->set_max_depth(depth);
+			Ref<BehaviorTree> bt = generator->generate();
+			int size = BehaviorTreeGenerator::get_task_count(bt->get_root_task());
+			Dictionary params;
+			params["tasks"] = size;
+			params["depth"] = depth;
+			int n = MAX(10, iterations / size);
+
+			report.measure("tree", vformat("clone_depth_%d", depth), n, [&]() { bt->get_root_task()->clone(); }, params);
+			report.measure("tree", vformat("instantiate_depth_%d", depth), n, [&]() { bt->instantiate(dummy, memnew(Blackboard), dummy, dummy); }, params);
+
+			Ref<BTInstance> inst = bt->instantiate(dummy, bt->get_blackboard_plan()->create_blackboard(dummy), dummy, dummy);
+			report.measure("tree", vformat("update_depth_%d", depth), n, [&]() { inst->update(0.01); }, params);
+		}
+	}
+
+	// * Blackboard access by scope depth (the variable lives in the outermost scope).
+	{
+		const int depths[] = { 1, 2, 4, 8 };
+		for (int depth : depths) {
+			Ref<Blackboard> outer = memnew(Blackboard);
+			outer->set_var("speed", 200.0);
+			Ref<Blackboard> scope = outer;
+			for (int i = 1; i < depth; i++) {
+				Ref<Blackboard> inner = memnew(Blackboard);
+				inner->set_parent(scope);
+				scope = inner;
+			}
+			Dictionary params;
+			params["depth"] = depth;
+
+			report.measure("blackboard", vformat("get_var_depth_%d", depth), iterations, [&]() { scope->get_var("speed"); }, params);
+			report.measure("blackboard", vformat("has_var_depth_%d", depth), iterations, [&]() { scope->has_var("speed"); }, params);
+		}
+		// Note: set_var() always writes to the local scope, so its cost doesn't depend on depth.
+		report.measure("blackboard", "set_var", iterations, [&]() { bb->set_var("speed", 100.0); });
+	}
+
+	report.write();
+	memdelete(dummy);
+}
+
+} //namespace TestBenchmarks
+
+#endif // TEST_BENCHMARKS_H
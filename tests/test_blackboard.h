@@ -179,6 +179,100 @@ TEST_CASE("[Modules][LimboAI] Test Blackboard") {
 		CHECK_EQ(blackboard->get_var("a", not_found), Variant(333));
 		CHECK_EQ(target_blackboard->get_var("aa", not_found), Variant(333));
 	}
+
+	SUBCASE("Test version counters") {
+		CHECK_EQ(blackboard->get_var_version("a"), 1);
+		CHECK_EQ(blackboard->get_var_version("not_found"), -1);
+		blackboard->set_var("a", 2);
+		blackboard->set_var("a", 2);
+		CHECK_EQ(blackboard->get_var_version("a"), 3);
+
+		Ref<Blackboard> child = memnew(Blackboard);
+		child->set_parent(blackboard);
+		CHECK_EQ(child->get_var_version("a"), 3);
+	}
+
+	SUBCASE("Test change notifications") {
+		Ref<CallbackCounter> counter = memnew(CallbackCounter);
+		blackboard->connect("var_changed", callable_mp(counter.ptr(), &CallbackCounter::callback).unbind(2));
+
+		blackboard->set_var("a", 2);
+		CHECK_EQ(counter->num_callbacks, 0);
+
+		blackboard->set_change_notification(Blackboard::CHANGE_NOTIFICATION_IMMEDIATE);
+		blackboard->set_var("a", 3);
+		blackboard->set_var("a", 4);
+		CHECK_EQ(counter->num_callbacks, 2);
+
+		counter->num_callbacks = 0;
+		blackboard->set_change_notification(Blackboard::CHANGE_NOTIFICATION_DEFERRED);
+		blackboard->set_var("a", 5);
+		blackboard->set_var("a", 6);
+		blackboard->set_var("b", Vector2());
+		CHECK_EQ(counter->num_callbacks, 0);
+		blackboard->flush_changes();
+		CHECK_EQ(counter->num_callbacks, 2);
+		blackboard->flush_changes();
+		CHECK_EQ(counter->num_callbacks, 2);
+	}
+
+	SUBCASE("Test change notifications in nested scopes") {
+		Ref<CallbackCounter> parent_counter = memnew(CallbackCounter);
+		Ref<CallbackCounter> child_counter = memnew(CallbackCounter);
+		Ref<Blackboard> child = memnew(Blackboard);
+		Ref<Blackboard> grandchild = memnew(Blackboard);
+		child->set_parent(blackboard);
+		grandchild->set_parent(child);
+		blackboard->connect("var_changed", callable_mp(parent_counter.ptr(), &CallbackCounter::callback).unbind(2));
+		grandchild->connect("var_changed", callable_mp(child_counter.ptr(), &CallbackCounter::callback).unbind(2));
+		blackboard->set_change_notification(Blackboard::CHANGE_NOTIFICATION_DEFERRED);
+		grandchild->set_change_notification(Blackboard::CHANGE_NOTIFICATION_DEFERRED);
+
+		blackboard->set_var("a", 2);
+		grandchild->set_var("x", 1);
+		grandchild->set_var("y", 1);
+
+		// Flushing from the innermost scope, like BTInstance does when the root task is BTNewScope.
+		grandchild->flush_scope_changes();
+		CHECK_EQ(parent_counter->num_callbacks, 1);
+		CHECK_EQ(child_counter->num_callbacks, 2);
+
+		// Flushing the top-most scope reaches the nested scope.
+		grandchild->set_var("x", 2);
+		blackboard->flush_changes();
+		CHECK_EQ(parent_counter->num_callbacks, 1);
+		CHECK_EQ(child_counter->num_callbacks, 3);
+
+		// Nested scopes with pending changes are not kept alive by the top-most scope.
+		grandchild->set_var("x", 3);
+		ObjectID grandchild_id = grandchild->get_instance_id();
+		grandchild.unref();
+		CHECK(ObjectDB::get_instance(grandchild_id) == nullptr);
+		blackboard->flush_changes();
+		CHECK_EQ(child_counter->num_callbacks, 3);
+	}
+
+	SUBCASE("Test change detection for bound properties") {
+		Ref<TestPropertyHolder> holder = memnew(TestPropertyHolder);
+		blackboard->bind_var_to_property("a", holder.ptr(), "property");
+		int64_t version = blackboard->get_var_version("a");
+		CHECK_EQ(blackboard->get_var_version("a"), version);
+
+		holder->set_property(5);
+		CHECK_EQ(blackboard->get_var_version("a"), version + 1);
+		CHECK_EQ(blackboard->get_var_version("a"), version + 1);
+
+		Ref<CallbackCounter> counter = memnew(CallbackCounter);
+		blackboard->connect("var_changed", callable_mp(counter.ptr(), &CallbackCounter::callback).unbind(2));
+		blackboard->set_change_notification(Blackboard::CHANGE_NOTIFICATION_DEFERRED);
+		blackboard->flush_changes();
+		CHECK_EQ(counter->num_callbacks, 0);
+		holder->set_property(6);
+		blackboard->flush_changes();
+		CHECK_EQ(counter->num_callbacks, 1);
+		blackboard->flush_changes();
+		CHECK_EQ(counter->num_callbacks, 1);
+	}
 }
 
 } //namespace TestBlackboard
@@ -0,0 +1,131 @@
+/**
+ * test_bt_instance.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BT_INSTANCE_H
+#define TEST_BT_INSTANCE_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/blackboard/blackboard.h"
+#include "modules/limboai/bt/bt_instance.h"
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+
+namespace TestBTInstance {
+
+TEST_CASE("[Modules][LimboAI] BTInstance snapshots") {
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	Ref<BTSequence> seq = memnew(BTSequence);
+	Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::SUCCESS));
+	Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::RUNNING));
+	Ref<BTTestAction> task3 = memnew(BTTestAction(BTTask::SUCCESS));
+	seq->add_child(task1);
+	seq->add_child(task2);
+	seq->add_child(task3);
+	seq->initialize(dummy, bb, dummy);
+	Ref<BTInstance> inst = BTInstance::create(seq, "", dummy);
+	REQUIRE(inst.is_valid());
+
+	SUBCASE("Task statuses and elapsed times are restored") {
+		inst->update(0.5);
+		inst->update(0.5);
+		REQUIRE(task2->get_status() == BTTask::RUNNING);
+		Array snapshot;
+		inst->save_snapshot(snapshot);
+
+		task2->ret_status = BTTask::FAILURE;
+		CHECK(inst->update(0.5) == BTTask::FAILURE);
+		CHECK(task2->get_status() == BTTask::FAILURE);
+
+		int pos = 0;
+		CHECK(inst->load_snapshot(snapshot, pos));
+		CHECK(pos == snapshot.size());
+		CHECK(inst->get_last_status() == BTTask::RUNNING);
+		CHECK(seq->get_status() == BTTask::RUNNING);
+		CHECK(task1->get_status() == BTTask::SUCCESS);
+		CHECK(task2->get_status() == BTTask::RUNNING);
+		CHECK(task2->get_elapsed_time() == doctest::Approx(0.5));
+
+		// Running tasks continue without re-entering.
+		task2->ret_status = BTTask::RUNNING;
+		int task2_entries = task2->num_entries;
+		inst->update(0.5);
+		CHECK(task2->num_entries == task2_entries);
+		CHECK(task2->get_elapsed_time() == doctest::Approx(1.0));
+	}
+
+	SUBCASE("Internal state of composites is restored") {
+		inst->update(0.5);
+		REQUIRE(task2->get_status() == BTTask::RUNNING);
+		Array snapshot;
+		inst->save_snapshot(snapshot);
+
+		// Move the sequence past the child that was running in the snapshot.
+		task2->ret_status = BTTask::SUCCESS;
+		task3->ret_status = BTTask::RUNNING;
+		inst->update(0.5);
+		REQUIRE(task3->get_status() == BTTask::RUNNING);
+
+		int pos = 0;
+		CHECK(inst->load_snapshot(snapshot, pos));
+		CHECK(task2->get_status() == BTTask::RUNNING);
+		CHECK(task3->get_status() == BTTask::FRESH);
+
+		// The sequence resumes at the restored child.
+		task2->ret_status = BTTask::RUNNING;
+		int task2_ticks = task2->num_ticks;
+		int task3_ticks = task3->num_ticks;
+		inst->update(0.5);
+		CHECK(task2->num_ticks == task2_ticks + 1);
+		CHECK(task3->num_ticks == task3_ticks);
+	}
+
+	SUBCASE("RNG state is restored") {
+		inst->get_rng()->randi();
+		Array snapshot;
+		inst->save_snapshot(snapshot);
+		uint32_t expected = inst->get_rng()->randi();
+		inst->get_rng()->randi();
+
+		int pos = 0;
+		CHECK(inst->load_snapshot(snapshot, pos));
+		CHECK(inst->get_rng()->randi() == expected);
+	}
+
+	SUBCASE("Unused RNG is released on restore") {
+		Array snapshot;
+		inst->save_snapshot(snapshot);
+		Ref<RandomNumberGenerator> rng = inst->get_rng();
+		REQUIRE(rng.is_valid());
+
+		int pos = 0;
+		CHECK(inst->load_snapshot(snapshot, pos));
+		CHECK(inst->get_rng() != rng);
+	}
+
+	SUBCASE("Mismatched snapshots are rejected") {
+		Array snapshot;
+		inst->save_snapshot(snapshot);
+		seq->add_child(memnew(BTTestAction));
+
+		int pos = 0;
+		ERR_PRINT_OFF;
+		CHECK_FALSE(inst->load_snapshot(snapshot, pos));
+		ERR_PRINT_ON;
+	}
+
+	memdelete(dummy);
+}
+
+} //namespace TestBTInstance
+
+#endif // TEST_BT_INSTANCE_H
@@ -16,6 +16,11 @@
 
 #include "modules/limboai/bt/behavior_tree.h"
 #include "modules/limboai/bt/bt_player.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+#include "modules/limboai/editor/debugger/behavior_tree_data.h"
+#include "modules/limboai/util/limbo_metrics.h"
+
+#include "core/os/thread.h"
 #include "scene/main/scene_tree.h"
 #include "scene/main/window.h"
 
@@ -227,4 +232,101 @@ TEST_CASE("[SceneTree][LimboAI] BTPlayer blackboard persistence") {
 	scene_root->queue_free();
 }
 
+TEST_CASE("[Modules][LimboAI] BTInstance execution trace") {
+	Node *owner = memnew(Node);
+	Ref<BTSequence> seq = memnew(BTSequence);
+	Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::SUCCESS));
+	Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::RUNNING));
+	seq->add_child(task1);
+	seq->add_child(task2);
+	Ref<BTInstance> inst = BTInstance::create(seq, "", owner);
+
+	CHECK(inst->get_trace_capacity() == 0);
+	inst->set_trace_capacity(4);
+	CHECK(inst->get_trace_capacity() == 4);
+
+	inst->update(0.1);
+	CHECK(inst->get_trace_event_count() == 3); // All three tasks left FRESH.
+	inst->update(0.1);
+	CHECK(inst->get_trace_event_count() == 3); // No transitions.
+
+	task2->ret_status = BTTask::FAILURE;
+	inst->update(0.1);
+	CHECK(inst->get_trace_event_count() == 4); // Ring buffer is full: the oldest event is dropped.
+
+	Ref<BehaviorTreeData> initial;
+	Vector<PackedByteArray> deltas;
+	REQUIRE(BehaviorTreeData::decode_trace(inst->dump_trace(), initial, deltas) == OK);
+	REQUIRE(initial->tasks.size() == 3);
+	CHECK(deltas.size() == 2); // One delta per tick with recorded transitions.
+	CHECK(initial->tasks[1].status == BTTask::FRESH);
+	CHECK(initial->tasks[2].status == BTTask::FRESH);
+	for (const PackedByteArray &delta : deltas) {
+		CHECK(initial->apply_delta(delta));
+	}
+	CHECK(initial->tasks[0].status == BTTask::FAILURE);
+	CHECK(initial->tasks[1].status == BTTask::SUCCESS);
+	CHECK(initial->tasks[2].status == BTTask::FAILURE);
+
+	ERR_PRINT_OFF;
+	CHECK(inst->save_trace("user://nonexistent_directory/trace.bin") != OK);
+	ERR_PRINT_ON;
+
+	// Tasks removed at runtime stay valid for the recorder.
+	seq->remove_child(task2);
+	task2.unref();
+	inst->update(0.1);
+	CHECK(inst->get_trace_event_count() == 4);
+
+	inst->set_trace_capacity(0);
+	CHECK(inst->get_trace_event_count() == 0);
+
+	memdelete(owner);
+}
+
+TEST_CASE("[Modules][LimboAI] LimboMetrics counters") {
+	REQUIRE(LimboMetrics::get_singleton());
+	LimboMetrics *metrics = LimboMetrics::get_singleton();
+	metrics->reset();
+
+	Node *owner = memnew(Node);
+	Ref<BTSequence> seq = memnew(BTSequence);
+	Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::SUCCESS));
+	Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::RUNNING));
+	seq->add_child(task1);
+	seq->add_child(task2);
+	Ref<BTInstance> inst = BTInstance::create(seq, "", owner);
+
+	inst->update(0.1);
+	inst->update(0.1);
+	CHECK(metrics->get_tick_count() == 2);
+	CHECK(metrics->get_tasks_executed_count() == 5); // The second update resumes at the running child.
+
+	Ref<Blackboard> bb = memnew(Blackboard);
+	bb->set_var("speed", 200.0);
+	bb->get_var("speed");
+	CHECK(metrics->get_blackboard_lookup_count() == 1);
+
+	// Counts of other threads are included, also after the thread exits.
+	Thread thread;
+	thread.start([](void *p_blackboard) { static_cast<Blackboard *>(p_blackboard)->get_var("speed"); }, bb.ptr());
+	thread.wait_to_finish();
+	CHECK(metrics->get_blackboard_lookup_count() == 2);
+
+	PackedInt64Array bounds = metrics->get_frame_time_histogram_bounds();
+	CHECK(bounds.size() == LimboMetrics::FRAME_TIME_BUCKET_COUNT - 1);
+	CHECK(bounds[0] == 64);
+	CHECK(metrics->get_frame_time_histogram().size() == LimboMetrics::FRAME_TIME_BUCKET_COUNT);
+	CHECK(metrics->get_metrics().has("tick_count"));
+
+	metrics->reset();
+	CHECK(metrics->get_tick_count() == 0);
+	CHECK(metrics->get_tasks_executed_count() == 0);
+	CHECK(metrics->get_blackboard_lookup_count() == 0);
+	inst->update(0.1);
+	CHECK(metrics->get_tasks_executed_count() == 2);
+
+	memdelete(owner);
+}
+
 } // namespace TestBTPlayer
@@ -0,0 +1,162 @@
+/**
+ * test_bt_state.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BT_STATE_H
+#define TEST_BT_STATE_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/bt_state.h"
+#include "modules/limboai/bt/tasks/utility/bt_wait.h"
+#include "modules/limboai/hsm/limbo_hsm.h"
+#include "modules/limboai/hsm/limbo_state.h"
+
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+
+namespace TestBTState {
+
+TEST_CASE("[SceneTree][LimboAI] BTState") {
+	Node *agent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(agent);
+
+	LimboHSM *hsm = memnew(LimboHSM);
+	hsm->set_update_mode(LimboHSM::MANUAL);
+	agent->add_child(hsm);
+	BTState *bt_state = memnew(BTState);
+	bt_state->set_scene_root_hint(agent);
+	hsm->add_child(bt_state);
+	LimboState *idle = memnew(LimboState);
+	hsm->add_child(idle);
+	hsm->add_transition(bt_state, idle, "to_idle");
+	hsm->add_transition(idle, bt_state, "to_bt");
+
+	Ref<BTWait> wait = memnew(BTWait);
+	wait->set_duration(100.0);
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	bt->set_root_task(wait);
+	bt_state->set_behavior_tree(bt);
+
+	SUBCASE("Test instantiate_on_enter") {
+		bt_state->set_instantiate_on_enter(true);
+		hsm->set_initial_state(idle);
+		hsm->initialize(agent);
+		hsm->set_active(true);
+		CHECK(bt_state->get_bt_instance().is_null());
+		hsm->dispatch("to_bt");
+		Ref<BTInstance> inst = bt_state->get_bt_instance();
+		REQUIRE(inst.is_valid());
+
+		SUBCASE("When release_delay is negative") {
+			bt_state->set_release_delay(-1.0);
+			hsm->dispatch("to_idle");
+			SceneTree::get_singleton()->process(100.0);
+			CHECK(bt_state->get_bt_instance() == inst);
+		}
+		SUBCASE("When release_delay is zero") {
+			bt_state->set_release_delay(0.0);
+			hsm->dispatch("to_idle");
+			CHECK(bt_state->get_bt_instance().is_null());
+			hsm->dispatch("to_bt");
+			CHECK(bt_state->get_bt_instance().is_valid());
+			CHECK(bt_state->get_bt_instance() != inst);
+		}
+		SUBCASE("When release_delay is positive") {
+			bt_state->set_release_delay(1.0);
+			hsm->dispatch("to_idle");
+			SceneTree::get_singleton()->process(0.6);
+			CHECK(bt_state->get_bt_instance() == inst);
+			SceneTree::get_singleton()->process(0.6);
+			CHECK(bt_state->get_bt_instance().is_null());
+		}
+		SUBCASE("When re-entered before release_delay runs out") {
+			bt_state->set_release_delay(1.0);
+			hsm->dispatch("to_idle");
+			SceneTree::get_singleton()->process(0.6);
+			hsm->dispatch("to_bt");
+			SceneTree::get_singleton()->process(0.6);
+			CHECK(bt_state->get_bt_instance() == inst);
+
+			// The countdown starts over on the next exit.
+			hsm->dispatch("to_idle");
+			SceneTree::get_singleton()->process(0.6);
+			CHECK(bt_state->get_bt_instance() == inst);
+			SceneTree::get_singleton()->process(0.6);
+			CHECK(bt_state->get_bt_instance().is_null());
+		}
+	}
+
+	SUBCASE("Test save_snapshot() and restore_snapshot()") {
+		hsm->initialize(agent);
+		hsm->set_active(true);
+		Ref<BTInstance> inst = bt_state->get_bt_instance();
+		REQUIRE(inst.is_valid());
+		hsm->update(1.0);
+		hsm->update(1.0);
+		inst->get_rng()->randi();
+		PackedByteArray snapshot = hsm->save_snapshot();
+		uint32_t expected_random = inst->get_rng()->randi();
+
+		hsm->update(1.0);
+		bt_state->get_blackboard()->set_var("created_later", 1);
+		hsm->dispatch("to_idle");
+		REQUIRE(hsm->get_active_state() == idle);
+
+		CHECK(hsm->restore_snapshot(snapshot) == OK);
+		CHECK(hsm->get_active_state() == bt_state);
+		CHECK(bt_state->get_bt_instance() == inst);
+		CHECK(inst->get_root_task()->get_status() == BTTask::RUNNING);
+		CHECK(inst->get_root_task()->get_elapsed_time() == doctest::Approx(1.0));
+		CHECK(inst->get_rng()->randi() == expected_random);
+		CHECK_FALSE(bt_state->get_blackboard()->has_var("created_later"));
+	}
+
+	SUBCASE("Test snapshots with instantiate_on_enter") {
+		bt_state->set_instantiate_on_enter(true);
+		bt_state->set_release_delay(0.0);
+		hsm->initialize(agent);
+		hsm->set_active(true);
+		REQUIRE(bt_state->get_bt_instance().is_valid());
+		hsm->update(1.0);
+		hsm->update(1.0);
+
+		SUBCASE("When the instance was released") {
+			hsm->dispatch("to_idle");
+			REQUIRE(bt_state->get_bt_instance().is_null());
+			PackedByteArray snapshot = hsm->save_snapshot();
+			hsm->dispatch("to_bt");
+			REQUIRE(bt_state->get_bt_instance().is_valid());
+
+			CHECK(hsm->restore_snapshot(snapshot) == OK);
+			CHECK(hsm->get_active_state() == idle);
+			CHECK(bt_state->get_bt_instance().is_null());
+		}
+		SUBCASE("When the instance was released after the snapshot") {
+			PackedByteArray snapshot = hsm->save_snapshot();
+			hsm->dispatch("to_idle");
+			REQUIRE(bt_state->get_bt_instance().is_null());
+
+			CHECK(hsm->restore_snapshot(snapshot) == OK);
+			CHECK(hsm->get_active_state() == bt_state);
+			Ref<BTInstance> inst = bt_state->get_bt_instance();
+			REQUIRE(inst.is_valid());
+			CHECK(inst->get_root_task()->get_status() == BTTask::RUNNING);
+			CHECK(inst->get_root_task()->get_elapsed_time() == doctest::Approx(1.0));
+		}
+	}
+
+	memdelete(agent);
+}
+
+} //namespace TestBTState
+
+#endif // TEST_BT_STATE_H
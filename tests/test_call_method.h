@@ -110,6 +110,32 @@ TEST_CASE("[Modules][LimboAI] BTCallMethod") {
 				CHECK(callback_counter->num_callbacks == 1);
 			}
 		}
+		SUBCASE("Should release argument values") {
+			Ref<CallbackCounter> arg_object = memnew(CallbackCounter);
+			TypedArray<BBVariant> args;
+			Ref<BBVariant> object_arg = memnew(BBVariant(arg_object));
+			int reference_count = arg_object->get_reference_count();
+
+			SUBCASE("When the call succeeds") {
+				// get_meta() returns the default value, which holds the object.
+				cm->set_method("get_meta");
+				args.push_back(memnew(BBVariant(String("not_found"))));
+				args.push_back(object_arg);
+				cm->set_args(args);
+				CHECK(cm->execute(0.01666) == BTTask::SUCCESS);
+				CHECK(arg_object->get_reference_count() == reference_count);
+			}
+			SUBCASE("When the call fails") {
+				cm->set_method("callback");
+				args.push_back(object_arg);
+				cm->set_args(args);
+				ERR_PRINT_OFF;
+				CHECK(cm->execute(0.01666) == BTTask::FAILURE);
+				ERR_PRINT_ON;
+				CHECK(callback_counter->num_callbacks == 0);
+				CHECK(arg_object->get_reference_count() == reference_count);
+			}
+		}
 
 		memdelete(dummy);
 	}
@@ -112,6 +112,51 @@ TEST_CASE("[Modules][LimboAI] BTForEach") {
 		CHECK_ENTRIES_TICKS_EXITS(task, 1, 1, 1); // Task is not re-executed as there is not enough elements to continue iteration.
 		CHECK(blackboard->get_var("element", "wetgoop") == "apple"); // Not changed.
 	}
+
+	SUBCASE("With cache_array enabled") {
+		fe->set_cache_array(true);
+		task->ret_status = BTTask::RUNNING;
+		CHECK(fe->execute(0.01666) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(task, 1, 1, 0);
+		CHECK(blackboard->get_var("element", "wetgoop") == "apple");
+
+		blackboard->set_var("element", "wetgoop");
+		CHECK(fe->execute(0.01666) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(task, 1, 2, 0);
+		CHECK(blackboard->get_var("element", "apple") == "wetgoop"); // * Not rewritten while on the same element.
+
+		task->ret_status = BTTask::SUCCESS;
+		CHECK(fe->execute(0.01666) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(task, 1, 3, 1);
+
+		CHECK(fe->execute(0.01666) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(task, 2, 4, 2);
+		CHECK(blackboard->get_var("element", "wetgoop") == "raspberry");
+
+		CHECK(fe->execute(0.01666) == BTTask::SUCCESS);
+		CHECK_ENTRIES_TICKS_EXITS(task, 3, 5, 3);
+		CHECK(blackboard->get_var("element", "wetgoop") == "mushroom");
+	}
+
+	SUBCASE("With a packed array") {
+		PackedVector3Array points;
+		points.push_back(Vector3(1, 0, 0));
+		points.push_back(Vector3(0, 1, 0));
+		blackboard->set_var("array", points);
+
+		SUBCASE("When cache_array is false") {
+			fe->set_cache_array(false);
+		}
+		SUBCASE("When cache_array is true") {
+			fe->set_cache_array(true);
+		}
+
+		CHECK(fe->execute(0.01666) == BTTask::RUNNING);
+		CHECK(blackboard->get_var("element", Vector3()) == Variant(Vector3(1, 0, 0)));
+		CHECK(fe->execute(0.01666) == BTTask::SUCCESS);
+		CHECK(blackboard->get_var("element", Vector3()) == Variant(Vector3(0, 1, 0)));
+		CHECK_ENTRIES_TICKS_EXITS(task, 2, 2, 2);
+	}
 }
 
 } //namespace TestForEach
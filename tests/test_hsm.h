@@ -15,6 +15,7 @@
 #include "limbo_test.h"
 
 #include "modules/limboai/hsm/limbo_hsm.h"
+#include "modules/limboai/hsm/limbo_hsm_scheduler.h"
 #include "modules/limboai/hsm/limbo_state.h"
 
 #include "core/object/object.h"
@@ -71,6 +72,27 @@ public:
 	bool can_enter() { return permitted_to_enter; }
 };
 
+class TestEventHandler : public RefCounted {
+	GDCLASS(TestEventHandler, RefCounted);
+
+public:
+	int num_events = 0;
+	Variant last_cargo;
+	bool handle(const Variant &p_cargo) {
+		num_events += 1;
+		last_cargo = p_cargo;
+		return true;
+	}
+};
+
+bool _native_guard(LimboState *p_state, void *p_userdata) {
+	return static_cast<TestGuard *>(p_userdata)->can_enter();
+}
+
+bool _native_event_handler(LimboState *p_state, const Variant &p_cargo, void *p_userdata) {
+	return static_cast<TestEventHandler *>(p_userdata)->handle(p_cargo);
+}
+
 TEST_CASE("[Modules][LimboAI] HSM") {
 	Ref<CallbackCounter> hsm_entries = memnew(CallbackCounter);
 	Ref<CallbackCounter> hsm_exits = memnew(CallbackCounter);
@@ -314,6 +336,169 @@ TEST_CASE("[Modules][LimboAI] HSM") {
 			CHECK(beta_entries->num_callbacks == 0);
 		}
 	}
+	SUBCASE("Test native guards and event handlers") {
+		Ref<TestGuard> guard = memnew(TestGuard);
+		Ref<TestEventHandler> handler = memnew(TestEventHandler);
+
+		SUBCASE("Native state guard") {
+			state_beta->set_native_guard(_native_guard, guard.ptr());
+			hsm->dispatch("event_one");
+			CHECK(hsm->get_active_state() == state_alpha);
+			guard->permitted_to_enter = true;
+			hsm->dispatch("event_one");
+			CHECK(hsm->get_active_state() == state_beta);
+		}
+		SUBCASE("Native transition guard") {
+			hsm->add_native_transition(state_alpha, state_beta, "native_transition", _native_guard, guard.ptr());
+			hsm->dispatch("native_transition");
+			CHECK(hsm->get_active_state() == state_alpha);
+			guard->permitted_to_enter = true;
+			hsm->dispatch("native_transition");
+			CHECK(hsm->get_active_state() == state_beta);
+		}
+		SUBCASE("Native event handler") {
+			state_alpha->add_native_event_handler("hit", _native_event_handler, handler.ptr());
+			CHECK(hsm->dispatch("hit", 5));
+			CHECK(handler->num_events == 1);
+			CHECK(handler->last_cargo == Variant(5));
+		}
+	}
+	SUBCASE("Test save_snapshot() and restore_snapshot()") {
+		hsm->get_blackboard()->set_var("health", 50);
+		hsm->dispatch("event_one");
+		REQUIRE(hsm->get_active_state() == state_beta);
+		PackedByteArray snapshot = hsm->save_snapshot();
+		CHECK_FALSE(snapshot.is_empty());
+
+		hsm->get_blackboard()->set_var("health", 10);
+		hsm->get_blackboard()->set_var("created_later", 1);
+		hsm->dispatch("goto_nested");
+		REQUIRE(hsm->get_active_state() == nested_hsm);
+		REQUIRE(nested_hsm->get_active_state() == state_gamma);
+
+		int beta_entries_before = beta_entries->num_callbacks;
+		int nested_exits_before = nested_exits->num_callbacks;
+		CHECK(hsm->restore_snapshot(snapshot) == OK);
+		CHECK(hsm->get_active_state() == state_beta);
+		CHECK(hsm->get_previous_active_state() == state_alpha);
+		CHECK(state_beta->is_active());
+		CHECK_FALSE(nested_hsm->is_active());
+		CHECK(nested_hsm->get_active_state() == nullptr);
+		CHECK(hsm->get_blackboard()->get_var("health", Variant()) == Variant(50));
+		CHECK_FALSE(hsm->get_blackboard()->has_var("created_later"));
+		// Restoring doesn't replay enter/exit.
+		CHECK(beta_entries->num_callbacks == beta_entries_before);
+		CHECK(nested_exits->num_callbacks == nested_exits_before);
+
+		hsm->dispatch("event_two");
+		CHECK(hsm->get_active_state() == state_alpha);
+
+		ERR_PRINT_OFF;
+		CHECK(hsm->restore_snapshot(PackedByteArray()) != OK);
+		ERR_PRINT_ON;
+	}
+	SUBCASE("When transitions and states change after initialization") {
+		hsm->remove_transition(state_alpha, "event_one");
+		hsm->dispatch("event_one");
+		CHECK(hsm->get_active_state() == state_alpha);
+
+		LimboState *state_epsilon = memnew(LimboState);
+		hsm->add_child(state_epsilon);
+		hsm->add_transition(state_alpha, state_epsilon, "goto_epsilon");
+		hsm->dispatch("goto_epsilon");
+		CHECK(hsm->get_active_state() == state_epsilon);
+
+		hsm->dispatch("goto_nested");
+		CHECK(hsm->get_active_state() == nested_hsm);
+	}
+	SUBCASE("Test posted events") {
+		Ref<TestEventHandler> handler = memnew(TestEventHandler);
+		state_alpha->add_event_handler("hit", callable_mp(handler.ptr(), &TestEventHandler::handle));
+
+		SUBCASE("Posted events are dispatched on update") {
+			hsm->post_event("hit", 1);
+			hsm->post_event("hit", 2);
+			CHECK(handler->num_events == 0);
+			hsm->update(0.01666);
+			CHECK(handler->num_events == 2);
+			CHECK(handler->last_cargo == Variant(2));
+		}
+		SUBCASE("Duplicate events are coalesced") {
+			hsm->set_coalesce_events(true);
+			hsm->post_event("hit", 1);
+			hsm->post_event("event_one");
+			hsm->post_event("hit", 2);
+			hsm->update(0.01666);
+			CHECK(handler->num_events == 1);
+			CHECK(handler->last_cargo == Variant(2));
+			CHECK(hsm->get_active_state() == state_beta);
+		}
+		SUBCASE("Events posted on a nested HSM are processed by the root") {
+			nested_hsm->post_event("hit", 3);
+			CHECK(handler->num_events == 0);
+			hsm->update(0.01666);
+			CHECK(handler->num_events == 1);
+			CHECK(handler->last_cargo == Variant(3));
+		}
+		SUBCASE("Coalescing keeps the order of distinct events") {
+			hsm->set_coalesce_events(true);
+			hsm->post_event("event_one");
+			hsm->post_event("hit", 1);
+			hsm->post_event("event_one");
+			hsm->post_event("hit", 2);
+			hsm->update(0.01666);
+			// "event_one" switches to state_beta before "hit" is dispatched.
+			CHECK(handler->num_events == 0);
+			CHECK(hsm->get_active_state() == state_beta);
+
+			hsm->post_event("event_two");
+			hsm->update(0.01666);
+			hsm->post_event("hit", 4);
+			hsm->post_event("hit", 5);
+			hsm->update(0.01666);
+			CHECK(handler->num_events == 1);
+			CHECK(handler->last_cargo == Variant(5));
+		}
+		SUBCASE("Pending events are discarded on exit") {
+			hsm->post_event("hit", 1);
+			hsm->set_active(false);
+			hsm->set_active(true);
+			hsm->update(0.01666);
+			CHECK(handler->num_events == 0);
+		}
+	}
+	SUBCASE("Test condition transitions") {
+		Ref<LimboGuard> low_health = memnew(LimboGuard);
+		low_health->set_variable("health");
+		low_health->set_check_type(LimboUtility::CHECK_LESS_THAN);
+		low_health->set_value(10);
+		hsm->add_condition_transition(state_alpha, state_beta, low_health);
+		CHECK(hsm->has_condition_transition(state_alpha, state_beta));
+
+		parent_scope->set_var("health", 50);
+		hsm->update(0.01666);
+		CHECK(hsm->get_active_state() == state_alpha);
+
+		parent_scope->set_var("health", 5.5); // Float against an int value.
+		hsm->update(0.01666);
+		CHECK(hsm->get_active_state() == state_beta);
+		CHECK(beta_updates->num_callbacks == 1);
+
+		Ref<LimboGuard> is_hidden = memnew(LimboGuard);
+		is_hidden->set_variable("hidden");
+		is_hidden->set_value(true);
+		state_alpha->set_guard_condition(is_hidden);
+		hsm->dispatch("event_two");
+		CHECK(hsm->get_active_state() == state_beta); // Entry not permitted.
+		parent_scope->set_var("hidden", true);
+		hsm->dispatch("event_two");
+		CHECK(hsm->get_active_state() == state_alpha);
+
+		hsm->remove_condition_transition(state_alpha, state_beta);
+		CHECK_FALSE(hsm->has_condition_transition(state_alpha, state_beta));
+		hsm->update(0.01666);
+		CHECK(hsm->get_active_state() == state_alpha);
+	}
 	SUBCASE("When there is no transition for given event") {
 		hsm->dispatch("not_found");
 		CHECK(alpha_exits->num_callbacks == 0);
@@ -377,6 +562,28 @@ TEST_CASE("[Modules][LimboAI] HSM") {
 		CHECK(nested_hsm->get_root() == hsm);
 		CHECK(state_delta->get_root() == hsm);
 		CHECK(state_gamma->get_root() == hsm);
+
+		// Root is updated on reparenting.
+		hsm->remove_child(nested_hsm);
+		CHECK(nested_hsm->is_root());
+		CHECK(state_gamma->get_root() == nested_hsm);
+		hsm->add_child(nested_hsm);
+		CHECK_FALSE(nested_hsm->is_root());
+		CHECK(state_gamma->get_root() == hsm);
+	}
+	SUBCASE("Test active path") {
+		REQUIRE(hsm->get_active_path().size() == 1);
+		CHECK(hsm->get_active_path()[0] == state_alpha);
+		hsm->dispatch("goto_nested");
+		REQUIRE(hsm->get_active_path().size() == 2);
+		CHECK(hsm->get_active_path()[0] == nested_hsm);
+		CHECK(hsm->get_active_path()[1] == state_gamma);
+		hsm->dispatch("goto_delta");
+		CHECK(hsm->get_leaf_state() == state_delta);
+		CHECK(nested_hsm->get_leaf_state() == state_delta);
+		hsm->set_active(false);
+		CHECK(hsm->get_active_path().is_empty());
+		CHECK(nested_hsm->get_leaf_state() == nested_hsm);
 	}
 	SUBCASE("Test restart()") {
 		REQUIRE(hsm->is_active());
@@ -458,6 +665,119 @@ TEST_CASE("[Modules][LimboAI] HSM") {
 	memdelete(agent);
 }
 
+TEST_CASE("[Modules][LimboAI] HSM process callbacks") {
+	Node *agent = memnew(Node);
+	LimboHSM *hsm = memnew(LimboHSM);
+	agent->add_child(hsm);
+	LimboState *state = memnew(LimboState);
+	hsm->add_child(state);
+	hsm->initialize(agent);
+
+	SUBCASE("All callbacks are enabled by default") {
+		hsm->set_active(true);
+		CHECK(state->is_processing());
+		CHECK(state->is_physics_processing());
+		CHECK(state->is_processing_input());
+		CHECK(state->is_processing_unhandled_input());
+
+		state->set_process_callbacks(LimboState::PROCESS_CALLBACK_UNHANDLED_INPUT);
+		CHECK_FALSE(state->is_processing());
+		CHECK_FALSE(state->is_physics_processing());
+		CHECK_FALSE(state->is_processing_input());
+		CHECK(state->is_processing_unhandled_input());
+
+		hsm->set_active(false);
+		CHECK_FALSE(state->is_processing_unhandled_input());
+	}
+	SUBCASE("Root HSM keeps processing needed by update mode") {
+		hsm->set_process_callbacks(0);
+		hsm->set_update_mode(LimboHSM::PHYSICS);
+		hsm->set_active(true);
+		CHECK(hsm->is_physics_processing());
+		CHECK_FALSE(hsm->is_processing());
+	}
+
+	memdelete(agent);
+}
+
+TEST_CASE("[Modules][LimboAI] HSM batch update") {
+	Node *agent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(agent);
+
+	Ref<CallbackCounter> counters[3];
+	LimboHSM *hsms[3];
+	for (int i = 0; i < 3; i++) {
+		counters[i] = Ref<CallbackCounter>(memnew(CallbackCounter));
+		hsms[i] = memnew(LimboHSM);
+		hsms[i]->set_update_mode(LimboHSM::PHYSICS);
+		hsms[i]->set_batch_update(true);
+		hsms[i]->set_process_callbacks(0);
+		agent->add_child(hsms[i]);
+		LimboState *state = memnew(LimboState);
+		state->set_process_callbacks(0);
+		state->call_on_update(callable_mp(counters[i].ptr(), &CallbackCounter::callback_delta));
+		hsms[i]->add_child(state);
+		hsms[i]->initialize(agent);
+		hsms[i]->set_active(true);
+	}
+
+	// The scheduler drives updates, so no HSM needs physics notifications.
+	CHECK(LimboHSMScheduler::get_root_count(true) == 3);
+	for (int i = 0; i < 3; i++) {
+		CHECK_FALSE(hsms[i]->is_physics_processing());
+	}
+
+	SceneTree::get_singleton()->emit_signal(SNAME("physics_frame"));
+	CHECK(counters[0]->num_callbacks == 1);
+	CHECK(counters[1]->num_callbacks == 1);
+	CHECK(counters[2]->num_callbacks == 1);
+
+	// Notifications delivered to batched HSMs are ignored.
+	hsms[1]->notification(Node::NOTIFICATION_PHYSICS_PROCESS);
+	CHECK(counters[1]->num_callbacks == 1);
+
+	// A paused HSM doesn't stop the others.
+	hsms[0]->set_process_mode(Node::PROCESS_MODE_DISABLED);
+	SceneTree::get_singleton()->emit_signal(SNAME("physics_frame"));
+	CHECK(counters[0]->num_callbacks == 1);
+	CHECK(counters[1]->num_callbacks == 2);
+	CHECK(counters[2]->num_callbacks == 2);
+	hsms[0]->set_process_mode(Node::PROCESS_MODE_INHERIT);
+
+	// Stopped HSMs are removed from the schedule.
+	hsms[1]->set_active(false);
+	CHECK(LimboHSMScheduler::get_root_count(true) == 2);
+	SceneTree::get_singleton()->emit_signal(SNAME("physics_frame"));
+	CHECK(counters[0]->num_callbacks == 2);
+	CHECK(counters[1]->num_callbacks == 2);
+	CHECK(counters[2]->num_callbacks == 3);
+
+	// Restarting the last scheduled HSM puts it back on the schedule.
+	hsms[2]->set_active(false);
+	hsms[2]->set_active(true);
+	CHECK(LimboHSMScheduler::get_root_count(true) == 2);
+	CHECK_FALSE(hsms[2]->is_physics_processing());
+	SceneTree::get_singleton()->emit_signal(SNAME("physics_frame"));
+	CHECK(counters[0]->num_callbacks == 3);
+	CHECK(counters[2]->num_callbacks == 4);
+
+	// Same for the only scheduled HSM.
+	hsms[0]->set_active(false);
+	hsms[2]->set_active(false);
+	CHECK(LimboHSMScheduler::get_root_count(true) == 0);
+	hsms[2]->set_active(true);
+	CHECK(LimboHSMScheduler::get_root_count(true) == 1);
+	SceneTree::get_singleton()->emit_signal(SNAME("physics_frame"));
+	CHECK(counters[0]->num_callbacks == 3);
+	CHECK(counters[2]->num_callbacks == 5);
+
+	hsms[2]->set_active(false);
+	CHECK(LimboHSMScheduler::get_root_count(true) == 0);
+
+	SceneTree::get_singleton()->get_root()->remove_child(agent);
+	memdelete(agent);
+}
+
 } //namespace TestHSM
 
 #endif // TEST_HSM_H
@@ -85,6 +85,31 @@ TEST_CASE("[SceneTree][LimboAI] BTPlayAnimation") {
 			CHECK(pa->execute(0.01666) == BTTask::SUCCESS);
 		}
 	}
+	SUBCASE("When using signals") {
+		player_param->set_saved_value(player->get_path());
+		pa->set_use_signals(true);
+		pa->set_await_completion(888.0);
+		pa->initialize(dummy, bb, dummy);
+		CHECK(pa->execute(0.01666) == BTTask::RUNNING);
+		CHECK(player->is_playing());
+
+		SUBCASE("When animation finishes playing") {
+			player->seek(888.0, true);
+			player->notification(Node::NOTIFICATION_INTERNAL_PROCESS);
+			CHECK_FALSE(player->is_playing());
+			CHECK(pa->execute(0.01666) == BTTask::SUCCESS);
+		}
+		SUBCASE("When another animation is played") {
+			player->emit_signal(SNAME("current_animation_changed"), String("other"));
+			CHECK(pa->execute(0.01666) == BTTask::SUCCESS);
+		}
+		SUBCASE("When AnimationPlayer is stopped") {
+			// stop() doesn't emit any of the tracked signals.
+			player->stop();
+			CHECK_FALSE(player->is_playing());
+			CHECK(pa->execute(0.01666) == BTTask::SUCCESS);
+		}
+	}
 
 	memdelete(dummy);
 	memdelete(player);
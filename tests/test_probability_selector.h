@@ -93,6 +93,61 @@ TEST_CASE("[Modules][LimboAI] BTProbabilitySelector") {
 		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::FAILURE, 1, 3, 1); // * continued & failed (1)
 		CHECK_STATUS_ENTRIES_TICKS_EXITS(task3, BTTask::FRESH, 0, 0, 0); // * ignored
 	}
+	SUBCASE("When weights change between executions") {
+		task1->ret_status = BTTask::SUCCESS;
+		task2->ret_status = BTTask::SUCCESS;
+		sel->set_weight(0, 1.0);
+		sel->set_weight(1, 0.0);
+		sel->set_weight(2, 0.0);
+
+		CHECK(sel->execute(0.01666) == BTTask::SUCCESS);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::SUCCESS, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::FRESH, 0, 0, 0);
+
+		sel->set_weight(0, 0.0);
+		sel->set_weight(1, 1.0);
+
+		CHECK(sel->execute(0.01666) == BTTask::SUCCESS);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::SUCCESS, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::SUCCESS, 1, 1, 1);
+	}
+	SUBCASE("When children are disabled or reordered between executions") {
+		task1->ret_status = BTTask::SUCCESS;
+		task2->ret_status = BTTask::SUCCESS;
+		task3->ret_status = BTTask::SUCCESS;
+		sel->set_weight(0, 1.0);
+		sel->set_weight(1, 0.0);
+		sel->set_weight(2, 0.0);
+
+		CHECK(sel->execute(0.01666) == BTTask::SUCCESS);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::SUCCESS, 1, 1, 1);
+
+		task1->set_enabled(false);
+		CHECK(sel->execute(0.01666) == BTTask::FAILURE);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::SUCCESS, 1, 1, 1);
+
+		// Move the only weighted child to the end without changing the child count.
+		task1->set_enabled(true);
+		sel->remove_child(task1);
+		sel->add_child(task1);
+		CHECK(sel->execute(0.01666) == BTTask::SUCCESS);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::SUCCESS, 2, 2, 2);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::FRESH, 0, 0, 0);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task3, BTTask::FRESH, 0, 0, 0);
+	}
+	SUBCASE("Failed children are not selected again within the same run") {
+		task1->ret_status = BTTask::FAILURE;
+		task2->ret_status = BTTask::FAILURE;
+		task3->ret_status = BTTask::FAILURE;
+		sel->set_weight(0, 1.0);
+		sel->set_weight(1, 100.0);
+		sel->set_weight(2, 10000.0);
+
+		CHECK(sel->execute(0.01666) == BTTask::FAILURE);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::FAILURE, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::FAILURE, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task3, BTTask::FAILURE, 1, 1, 1);
+	}
 	SUBCASE("When all return SUCCESS status") {
 		task1->ret_status = BTTask::SUCCESS;
 		task2->ret_status = BTTask::SUCCESS;
@@ -14,6 +14,7 @@
 
 #include "limbo_test.h"
 
+#include "modules/limboai/bt/bt_instance.h"
 #include "modules/limboai/bt/tasks/bt_task.h"
 #include "modules/limboai/bt/tasks/composites/bt_random_selector.h"
 
@@ -105,6 +106,44 @@ TEST_CASE("[Modules][LimboAI] Empty BTRandomSelector returns FAILURE") {
 	CHECK(seq->execute(0.01666) == BTTask::FAILURE);
 }
 
+TEST_CASE("[Modules][LimboAI] BTRandomSelector is reproducible with a seeded BTInstance RNG") {
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> blackboard = memnew(Blackboard);
+	const int num_children = 5;
+	const int num_runs = 20;
+
+	Vector<int> picks[2];
+	for (int attempt = 0; attempt < 2; attempt++) {
+		Ref<BTRandomSelector> sel = memnew(BTRandomSelector);
+		Ref<BTTestAction> tasks[num_children];
+		for (int i = 0; i < num_children; i++) {
+			tasks[i] = memnew(BTTestAction(BTTask::RUNNING));
+			sel->add_child(tasks[i]);
+		}
+		sel->initialize(dummy, blackboard, dummy);
+		Ref<BTInstance> inst = BTInstance::create(sel, "", dummy);
+		REQUIRE(inst.is_valid());
+		CHECK(sel->get_rng() == inst->get_rng());
+		CHECK(tasks[0]->get_rng() == inst->get_rng());
+		inst->get_rng()->set_seed(12345);
+
+		for (int run = 0; run < num_runs; run++) {
+			CHECK(inst->update(0.01666) == BTTask::RUNNING);
+			for (int i = 0; i < num_children; i++) {
+				if (tasks[i]->get_status() == BTTask::RUNNING) {
+					picks[attempt].push_back(i);
+				}
+			}
+			sel->abort();
+		}
+	}
+
+	CHECK(picks[0].size() == num_runs);
+	CHECK(picks[0] == picks[1]);
+
+	memdelete(dummy);
+}
+
 } //namespace TestRandomSelector
 
 #endif // TEST_RANDOM_SELECTOR_H
@@ -0,0 +1,173 @@
+/**
+ * limbo_metrics.cpp
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "limbo_metrics.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/config/engine.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/engine.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+LimboMetrics *LimboMetrics::singleton = nullptr;
+
+thread_local LimboMetrics::ThreadCounters LimboMetrics::thread_counters;
+LIMBO_MUTEX LimboMetrics::thread_counters_mutex;
+Vector<LimboMetrics::ThreadCounters *> LimboMetrics::live_thread_counters;
+uint64_t LimboMetrics::retired_tasks_executed = 0;
+uint64_t LimboMetrics::retired_blackboard_lookups = 0;
+std::atomic<uint64_t> LimboMetrics::tasks_executed_base{ 0 };
+std::atomic<uint64_t> LimboMetrics::blackboard_lookup_base{ 0 };
+
+std::atomic<uint64_t> LimboMetrics::tick_count{ 0 };
+std::atomic<uint64_t> LimboMetrics::instantiation_count{ 0 };
+
+std::atomic<bool> LimboMetrics::frame_time_histogram_enabled{ false };
+std::atomic<uint64_t> LimboMetrics::current_frame{ 0 };
+std::atomic<uint64_t> LimboMetrics::current_frame_time_usec{ 0 };
+std::atomic<uint64_t> LimboMetrics::frame_time_histogram[FRAME_TIME_BUCKET_COUNT] = {};
+
+LimboMetrics::ThreadCounters::ThreadCounters() {
+	LIMBO_MUTEX_LOCK(thread_counters_mutex);
+	live_thread_counters.push_back(this);
+}
+
+LimboMetrics::ThreadCounters::~ThreadCounters() {
+	LIMBO_MUTEX_LOCK(thread_counters_mutex);
+	// Keep the counts of exited threads in the totals.
+	retired_tasks_executed += tasks_executed.load(std::memory_order_relaxed);
+	retired_blackboard_lookups += blackboard_lookups.load(std::memory_order_relaxed);
+	live_thread_counters.erase(this);
+}
+
+void LimboMetrics::_sum_thread_counters(uint64_t &r_tasks_executed, uint64_t &r_blackboard_lookups) {
+	LIMBO_MUTEX_LOCK(thread_counters_mutex);
+	r_tasks_executed = retired_tasks_executed;
+	r_blackboard_lookups = retired_blackboard_lookups;
+	for (const ThreadCounters *counters : live_thread_counters) {
+		r_tasks_executed += counters->tasks_executed.load(std::memory_order_relaxed);
+		r_blackboard_lookups += counters->blackboard_lookups.load(std::memory_order_relaxed);
+	}
+}
+
+int64_t LimboMetrics::get_tasks_executed_count() const {
+	uint64_t tasks_executed;
+	uint64_t blackboard_lookups;
+	_sum_thread_counters(tasks_executed, blackboard_lookups);
+	return tasks_executed - tasks_executed_base.load(std::memory_order_relaxed);
+}
+
+int64_t LimboMetrics::get_blackboard_lookup_count() const {
+	uint64_t tasks_executed;
+	uint64_t blackboard_lookups;
+	_sum_thread_counters(tasks_executed, blackboard_lookups);
+	return blackboard_lookups - blackboard_lookup_base.load(std::memory_order_relaxed);
+}
+
+int LimboMetrics::_get_frame_time_bucket(uint64_t p_usec) {
+	int bucket = 0;
+	uint64_t v = p_usec >> FRAME_TIME_FIRST_BOUND_SHIFT;
+	while (v && bucket < FRAME_TIME_BUCKET_COUNT - 1) {
+		v >>= 1;
+		bucket += 1;
+	}
+	return bucket;
+}
+
+void LimboMetrics::_flush_frame(uint64_t p_frame) {
+	uint64_t last_frame = current_frame.load(std::memory_order_relaxed);
+	// Only one thread gets to close the previous frame.
+	if (last_frame != p_frame && current_frame.compare_exchange_strong(last_frame, p_frame, std::memory_order_relaxed)) {
+		uint64_t frame_time = current_frame_time_usec.exchange(0, std::memory_order_relaxed);
+		if (frame_time > 0) {
+			frame_time_histogram[_get_frame_time_bucket(frame_time)].fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+}
+
+void LimboMetrics::add_update_time(uint64_t p_usec) {
+	uint64_t frame = Engine::get_singleton()->get_process_frames();
+	if (unlikely(frame != current_frame.load(std::memory_order_relaxed))) {
+		_flush_frame(frame);
+	}
+	current_frame_time_usec.fetch_add(p_usec, std::memory_order_relaxed);
+}
+
+PackedInt64Array LimboMetrics::get_frame_time_histogram() const {
+	PackedInt64Array histogram;
+	histogram.resize(FRAME_TIME_BUCKET_COUNT);
+	for (int i = 0; i < FRAME_TIME_BUCKET_COUNT; i++) {
+		histogram.set(i, frame_time_histogram[i].load(std::memory_order_relaxed));
+	}
+	return histogram;
+}
+
+PackedInt64Array LimboMetrics::get_frame_time_histogram_bounds() const {
+	PackedInt64Array bounds;
+	bounds.resize(FRAME_TIME_BUCKET_COUNT - 1);
+	for (int i = 0; i < FRAME_TIME_BUCKET_COUNT - 1; i++) {
+		bounds.set(i, int64_t(1) << (FRAME_TIME_FIRST_BOUND_SHIFT + i));
+	}
+	return bounds;
+}
+
+Dictionary LimboMetrics::get_metrics() const {
+	Dictionary metrics;
+	metrics["tick_count"] = get_tick_count();
+	metrics["tasks_executed_count"] = get_tasks_executed_count();
+	metrics["instantiation_count"] = get_instantiation_count();
+	metrics["blackboard_lookup_count"] = get_blackboard_lookup_count();
+	metrics["frame_time_histogram"] = get_frame_time_histogram();
+	metrics["frame_time_histogram_bounds"] = get_frame_time_histogram_bounds();
+	return metrics;
+}
+
+void LimboMetrics::reset() {
+	// Thread-local counters are only written by their threads, so they are offset instead of cleared.
+	uint64_t tasks_executed;
+	uint64_t blackboard_lookups;
+	_sum_thread_counters(tasks_executed, blackboard_lookups);
+	tasks_executed_base.store(tasks_executed, std::memory_order_relaxed);
+	blackboard_lookup_base.store(blackboard_lookups, std::memory_order_relaxed);
+
+	tick_count.store(0, std::memory_order_relaxed);
+	instantiation_count.store(0, std::memory_order_relaxed);
+	current_frame.store(0, std::memory_order_relaxed);
+	current_frame_time_usec.store(0, std::memory_order_relaxed);
+	for (int i = 0; i < FRAME_TIME_BUCKET_COUNT; i++) {
+		frame_time_histogram[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+void LimboMetrics::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_tick_count"), &LimboMetrics::get_tick_count);
+	ClassDB::bind_method(D_METHOD("get_tasks_executed_count"), &LimboMetrics::get_tasks_executed_count);
+	ClassDB::bind_method(D_METHOD("get_instantiation_count"), &LimboMetrics::get_instantiation_count);
+	ClassDB::bind_method(D_METHOD("get_blackboard_lookup_count"), &LimboMetrics::get_blackboard_lookup_count);
+	ClassDB::bind_method(D_METHOD("get_frame_time_histogram"), &LimboMetrics::get_frame_time_histogram);
+	ClassDB::bind_method(D_METHOD("get_frame_time_histogram_bounds"), &LimboMetrics::get_frame_time_histogram_bounds);
+	ClassDB::bind_method(D_METHOD("get_metrics"), &LimboMetrics::get_metrics);
+	ClassDB::bind_method(D_METHOD("reset"), &LimboMetrics::reset);
+	ClassDB::bind_method(D_METHOD("set_frame_time_histogram_enabled", "enabled"), &LimboMetrics::set_frame_time_histogram_enabled);
+	ClassDB::bind_method(D_METHOD("get_frame_time_histogram_enabled"), &LimboMetrics::get_frame_time_histogram_enabled);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "frame_time_histogram_enabled"), "set_frame_time_histogram_enabled", "get_frame_time_histogram_enabled");
+}
+
+LimboMetrics::LimboMetrics() {
+	singleton = this;
+}
+
+LimboMetrics::~LimboMetrics() {
+	singleton = nullptr;
+}
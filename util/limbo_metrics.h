@@ -0,0 +1,113 @@
+/**
+ * limbo_metrics.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef LIMBO_METRICS_H
+#define LIMBO_METRICS_H
+
+#include "../compat/mutex.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/object/class_db.h"
+#include "core/object/object.h"
+#include "core/templates/vector.h"
+#include "core/variant/dictionary.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/templates/vector.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+#include <atomic>
+
+// Lightweight global counters that are available in all builds, including release.
+// Per-task and per-lookup counts go to thread-local counters that are summed on read, so that hot paths
+// on different threads don't write to a shared cache line. Reading is done from script via the LimboMetrics singleton.
+class LimboMetrics : public Object {
+	GDCLASS(LimboMetrics, Object);
+
+public:
+	// Frame time buckets: the first bucket covers [0, 64) usec, each next one doubles the bound,
+	// and the last bucket is open-ended.
+	static constexpr int FRAME_TIME_BUCKET_COUNT = 10;
+	static constexpr int FRAME_TIME_FIRST_BOUND_SHIFT = 6;
+
+private:
+	static LimboMetrics *singleton;
+
+	// Written only by the owning thread.
+	struct ThreadCounters {
+		std::atomic<uint64_t> tasks_executed{ 0 };
+		std::atomic<uint64_t> blackboard_lookups{ 0 };
+
+		ThreadCounters();
+		~ThreadCounters();
+	};
+
+	static thread_local ThreadCounters thread_counters;
+	static LIMBO_MUTEX thread_counters_mutex;
+	static Vector<ThreadCounters *> live_thread_counters;
+	static uint64_t retired_tasks_executed; // Counts of exited threads.
+	static uint64_t retired_blackboard_lookups;
+	static std::atomic<uint64_t> tasks_executed_base; // Totals at the last reset().
+	static std::atomic<uint64_t> blackboard_lookup_base;
+
+	static std::atomic<uint64_t> tick_count;
+	static std::atomic<uint64_t> instantiation_count;
+
+	static std::atomic<bool> frame_time_histogram_enabled;
+	static std::atomic<uint64_t> current_frame;
+	static std::atomic<uint64_t> current_frame_time_usec;
+	static std::atomic<uint64_t> frame_time_histogram[FRAME_TIME_BUCKET_COUNT];
+
+	static _FORCE_INLINE_ void _increment(std::atomic<uint64_t> &p_counter) { p_counter.store(p_counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+	static void _sum_thread_counters(uint64_t &r_tasks_executed, uint64_t &r_blackboard_lookups);
+
+	static int _get_frame_time_bucket(uint64_t p_usec);
+	static void _flush_frame(uint64_t p_frame);
+
+protected:
+	static void _bind_methods();
+
+public:
+	static LimboMetrics *get_singleton() { return singleton; }
+
+	static _FORCE_INLINE_ void count_tick() { tick_count.fetch_add(1, std::memory_order_relaxed); }
+	static _FORCE_INLINE_ void count_task_executed() { _increment(thread_counters.tasks_executed); }
+	static _FORCE_INLINE_ void count_instantiation() { instantiation_count.fetch_add(1, std::memory_order_relaxed); }
+	static _FORCE_INLINE_ void count_blackboard_lookup() { _increment(thread_counters.blackboard_lookups); }
+
+	// Update time is only measured for the histogram while it's enabled.
+	static _FORCE_INLINE_ bool is_frame_time_histogram_enabled() { return frame_time_histogram_enabled.load(std::memory_order_relaxed); }
+	// Adds AI update time to the current frame total. The total is added to the histogram once a new frame begins.
+	static void add_update_time(uint64_t p_usec);
+
+	int64_t get_tick_count() const { return tick_count.load(std::memory_order_relaxed); }
+	int64_t get_tasks_executed_count() const;
+	int64_t get_instantiation_count() const { return instantiation_count.load(std::memory_order_relaxed); }
+	int64_t get_blackboard_lookup_count() const;
+
+	void set_frame_time_histogram_enabled(bool p_enabled) { frame_time_histogram_enabled.store(p_enabled, std::memory_order_relaxed); }
+	bool get_frame_time_histogram_enabled() const { return is_frame_time_histogram_enabled(); }
+
+	PackedInt64Array get_frame_time_histogram() const;
+	PackedInt64Array get_frame_time_histogram_bounds() const;
+
+	Dictionary get_metrics() const;
+	void reset();
+
+	LimboMetrics();
+	~LimboMetrics();
+};
+
+#endif // LIMBO_METRICS_H
@@ -0,0 +1,167 @@
+/**
+ * limbo_profiler.cpp
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "limbo_profiler.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/config/engine.h"
+#include "core/os/thread.h"
+#include "core/os/time.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/time.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+LimboProfiler *LimboProfiler::singleton = nullptr;
+std::atomic<bool> LimboProfiler::capturing{ false };
+
+void LimboProfiler::_push_event(EventType p_type, const char *p_category, const String &p_name, uint64_t p_timestamp_usec, uint64_t p_duration_usec) {
+#ifdef LIMBOAI_MODULE
+	uint64_t caller_id = Thread::get_caller_id();
+#elif LIMBOAI_GDEXTENSION
+	uint64_t caller_id = OS::get_singleton()->get_thread_caller_id();
+#endif
+	uint64_t frame = Engine::get_singleton()->get_process_frames();
+
+	LIMBO_MUTEX_LOCK(mutex);
+	if (!is_active()) {
+		return;
+	}
+	if ((int)events.size() >= max_events) {
+		dropped_events += 1;
+		return;
+	}
+
+	int *thread = thread_ids.getptr(caller_id);
+	if (thread == nullptr) {
+		thread = &thread_ids.insert(caller_id, thread_ids.size() + 1)->value;
+	}
+
+	if (frame != last_frame) {
+		// Frame markers let AI activity be lined up against engine frames.
+		last_frame = frame;
+		Event marker;
+		marker.type = EVENT_FRAME;
+		marker.category = "frame";
+		marker.name = vformat("Frame %d", (int64_t)frame);
+		marker.timestamp_usec = p_timestamp_usec;
+		marker.frame = frame;
+		marker.thread = *thread;
+		events.push_back(marker);
+	}
+
+	Event ev;
+	ev.type = p_type;
+	ev.category = p_category;
+	ev.name = p_name;
+	ev.timestamp_usec = p_timestamp_usec;
+	ev.duration_usec = p_duration_usec;
+	ev.frame = frame;
+	ev.thread = *thread;
+	events.push_back(ev);
+}
+
+void LimboProfiler::add_span(const char *p_category, const String &p_name, uint64_t p_start_usec, uint64_t p_end_usec) {
+	ERR_FAIL_NULL(singleton);
+	singleton->_push_event(EVENT_SPAN, p_category, p_name, p_start_usec, p_end_usec - p_start_usec);
+}
+
+void LimboProfiler::add_instant(const char *p_category, const String &p_name) {
+	ERR_FAIL_NULL(singleton);
+	singleton->_push_event(EVENT_INSTANT, p_category, p_name, Time::get_singleton()->get_ticks_usec(), 0);
+}
+
+String LimboProfiler::_event_to_json(const Event &p_event) const {
+	String common = vformat("\"name\":\"%s\",\"cat\":\"%s\",\"ts\":%d,\"pid\":1,\"tid\":%d,\"args\":{\"frame\":%d}",
+			p_event.name.json_escape(), p_event.category, (int64_t)p_event.timestamp_usec, p_event.thread, (int64_t)p_event.frame);
+	switch (p_event.type) {
+		case EVENT_SPAN: {
+			return vformat("{%s,\"ph\":\"X\",\"dur\":%d}", common, (int64_t)p_event.duration_usec);
+		}
+		case EVENT_INSTANT: {
+			return vformat("{%s,\"ph\":\"i\",\"s\":\"t\"}", common);
+		}
+		case EVENT_FRAME: {
+			return vformat("{%s,\"ph\":\"i\",\"s\":\"g\"}", common);
+		}
+	}
+	return String();
+}
+
+Error LimboProfiler::start_capture(const String &p_path, int p_task_threshold_usec) {
+	ERR_FAIL_COND_V_MSG(is_active(), ERR_ALREADY_IN_USE, "LimboProfiler: Capture is already in progress.");
+	ERR_FAIL_COND_V_MSG(p_task_threshold_usec < 0, ERR_INVALID_PARAMETER, "LimboProfiler: Task threshold can't be negative.");
+
+	// Open the file early, so that an invalid path is reported before anything is recorded.
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_OPEN, "LimboProfiler: Failed to open file for writing: " + p_path);
+
+	LIMBO_MUTEX_LOCK(mutex);
+	file = f;
+	events.clear();
+	thread_ids.clear();
+	last_frame = UINT64_MAX;
+	dropped_events = 0;
+	task_threshold_usec = p_task_threshold_usec;
+	capturing.store(true, std::memory_order_relaxed);
+	return OK;
+}
+
+Error LimboProfiler::stop_capture() {
+	ERR_FAIL_COND_V_MSG(!is_active(), ERR_UNCONFIGURED, "LimboProfiler: No capture in progress.");
+
+	LIMBO_MUTEX_LOCK(mutex);
+	capturing.store(false, std::memory_order_relaxed);
+
+	file->store_string("{\"traceEvents\":[\n");
+	for (uint32_t i = 0; i < events.size(); i++) {
+		file->store_string(_event_to_json(events[i]));
+		file->store_string(i + 1 < events.size() ? ",\n" : "\n");
+	}
+	file->store_string(vformat("],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":%d}}\n", dropped_events));
+	if (dropped_events > 0) {
+		WARN_PRINT(vformat("LimboProfiler: %d events were dropped. Increase max_events to capture longer sessions.", dropped_events));
+	}
+
+	Error err = file->get_error();
+	file.unref();
+	events.clear();
+	thread_ids.clear();
+	return err;
+}
+
+void LimboProfiler::set_max_events(int p_max_events) {
+	ERR_FAIL_COND_MSG(p_max_events < 1, "LimboProfiler: max_events must be greater than zero.");
+	LIMBO_MUTEX_LOCK(mutex);
+	max_events = p_max_events;
+}
+
+void LimboProfiler::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("start_capture", "path", "task_threshold_usec"), &LimboProfiler::start_capture, DEFVAL(100));
+	ClassDB::bind_method(D_METHOD("stop_capture"), &LimboProfiler::stop_capture);
+	ClassDB::bind_method(D_METHOD("is_capturing"), &LimboProfiler::is_capturing);
+	ClassDB::bind_method(D_METHOD("set_max_events", "max_events"), &LimboProfiler::set_max_events);
+	ClassDB::bind_method(D_METHOD("get_max_events"), &LimboProfiler::get_max_events);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_events", PROPERTY_HINT_RANGE, "1,10000000,1,or_greater"), "set_max_events", "get_max_events");
+}
+
+LimboProfiler::LimboProfiler() {
+	singleton = this;
+}
+
+LimboProfiler::~LimboProfiler() {
+	capturing.store(false, std::memory_order_relaxed);
+	singleton = nullptr;
+}
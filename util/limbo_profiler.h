@@ -0,0 +1,96 @@
+/**
+ * limbo_profiler.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef LIMBO_PROFILER_H
+#define LIMBO_PROFILER_H
+
+#include "../compat/mutex.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/io/file_access.h"
+#include "core/object/class_db.h"
+#include "core/object/object.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+#include <atomic>
+
+// Captures behavior tree and state machine activity and exports it in Chrome trace event format (JSON),
+// which can be opened in chrome://tracing or ui.perfetto.dev.
+// Events are kept in memory while capturing and written to file when the capture is stopped.
+class LimboProfiler : public Object {
+	GDCLASS(LimboProfiler, Object);
+
+private:
+	enum EventType : uint8_t {
+		EVENT_SPAN,
+		EVENT_INSTANT,
+		EVENT_FRAME,
+	};
+
+	struct Event {
+		EventType type = EVENT_SPAN;
+		const char *category = "";
+		String name;
+		uint64_t timestamp_usec = 0;
+		uint64_t duration_usec = 0;
+		uint64_t frame = 0;
+		int thread = 0;
+	};
+
+	static LimboProfiler *singleton;
+	static std::atomic<bool> capturing;
+
+	LIMBO_MUTEX mutex;
+	Ref<FileAccess> file;
+	LocalVector<Event> events;
+	HashMap<uint64_t, int> thread_ids;
+	uint64_t last_frame = UINT64_MAX;
+	uint64_t task_threshold_usec = 100;
+	int max_events = 1000000;
+	int dropped_events = 0;
+
+	void _push_event(EventType p_type, const char *p_category, const String &p_name, uint64_t p_timestamp_usec, uint64_t p_duration_usec);
+	String _event_to_json(const Event &p_event) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	static LimboProfiler *get_singleton() { return singleton; }
+
+	static _FORCE_INLINE_ bool is_active() { return capturing.load(std::memory_order_relaxed); }
+	static _FORCE_INLINE_ uint64_t get_task_threshold() { return singleton->task_threshold_usec; }
+
+	static void add_span(const char *p_category, const String &p_name, uint64_t p_start_usec, uint64_t p_end_usec);
+	static void add_instant(const char *p_category, const String &p_name);
+
+	Error start_capture(const String &p_path, int p_task_threshold_usec = 100);
+	Error stop_capture();
+	bool is_capturing() const { return is_active(); }
+
+	void set_max_events(int p_max_events);
+	int get_max_events() const { return max_events; }
+
+	LimboProfiler();
+	~LimboProfiler();
+};
+
+#endif // LIMBO_PROFILER_H
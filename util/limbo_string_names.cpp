@@ -28,7 +28,10 @@ LimboStringNames::LimboStringNames() {
 	Add = StringName("Add");
 	add_child = StringName("add_child");
 	add_child_at_index = StringName("add_child_at_index");
+	animation_changed = StringName("animation_changed");
+	animation_finished = StringName("animation_finished");
 	AnimationFilter = StringName("AnimationFilter");
+	batch_update = StringName("batch_update");
 	BBParam = StringName("BBParam");
 	BBString = StringName("BBString");
 	behavior_tree_finished = StringName("behavior_tree_finished");
@@ -41,6 +44,8 @@ LimboStringNames::LimboStringNames() {
 	class_icon_size = StringName("class_icon_size");
 	Clear = StringName("Clear");
 	Close = StringName("Close");
+	coalesce_events = StringName("coalesce_events");
+	current_animation_changed = StringName("current_animation_changed");
 	dark_color_2 = StringName("dark_color_2");
 	Debug = StringName("Debug");
 	disabled_font_color = StringName("disabled_font_color");
@@ -103,10 +108,13 @@ LimboStringNames::LimboStringNames() {
 	NonFavorite = StringName("NonFavorite");
 	normal = StringName("normal");
 	panel = StringName("panel");
+	Pause = StringName("Pause");
+	physics_frame = StringName("physics_frame");
 	plan_changed = StringName("plan_changed");
 	popup_hide = StringName("popup_hide");
 	pressed = StringName("pressed");
 	probability_clicked = StringName("probability_clicked");
+	process_frame = StringName("process_frame");
 	property_changed = StringName("property_changed");
 	ready = StringName("ready");
 	Reload = StringName("Reload");
@@ -145,6 +153,8 @@ LimboStringNames::LimboStringNames() {
 	TripleBar = StringName("TripleBar");
 	update_mode = StringName("update_mode");
 	updated = StringName("updated");
+	value_changed = StringName("value_changed");
+	var_changed = StringName("var_changed");
 	variable = StringName("variable");
 	visibility_changed = StringName("visibility_changed");
 	window_visibility_changed = StringName("window_visibility_changed");
@@ -55,7 +55,10 @@ public:
 	StringName add_child_at_index;
 	StringName add_child;
 	StringName Add;
+	StringName animation_changed;
+	StringName animation_finished;
 	StringName AnimationFilter;
+	StringName batch_update;
 	StringName BBParam;
 	StringName BBString;
 	StringName behavior_tree_finished;
@@ -68,6 +71,8 @@ public:
 	StringName class_icon_size;
 	StringName Clear;
 	StringName Close;
+	StringName coalesce_events;
+	StringName current_animation_changed;
 	StringName dark_color_2;
 	StringName Debug;
 	StringName disabled_font_color;
@@ -130,10 +135,13 @@ public:
 	StringName NonFavorite;
 	StringName normal;
 	StringName panel;
+	StringName Pause;
+	StringName physics_frame;
 	StringName plan_changed;
 	StringName popup_hide;
 	StringName pressed;
 	StringName probability_clicked;
+	StringName process_frame;
 	StringName property_changed;
 	StringName ready;
 	StringName Reload;
@@ -172,6 +180,8 @@ public:
 	StringName TripleBar;
 	StringName update_mode;
 	StringName updated;
+	StringName value_changed;
+	StringName var_changed;
 	StringName variable;
 	StringName visibility_changed;
 	StringName window_visibility_changed;